@@ -45,6 +45,7 @@
 #include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
@@ -70,6 +71,7 @@
 #include "src/common/uid.h"
 #include "src/common/xmalloc.h"
 #include "src/common/xstring.h"
+#include "src/interfaces/hash.h"
 
 #include "file_bcast.h"
 
@@ -81,17 +83,28 @@
 #define DEFAULT_THREADS 8
 #define MAX_THREADS     64	/* These can be huge messages, so
 				 * only run MAX_THREADS at one time */
+#define PIPELINE_DEPTH  4	/* blocks in flight through the tree */
+#define HASH_CHUNK_SIZE (1024 * 1024 * 1024) /* bytes hashed per pass */
 
 int block_len;				/* block size */
 int fd;					/* source file descriptor */
 void *src;				/* source mmap'd address */
 struct stat f_stat;			/* source file stats */
 job_sbcast_cred_msg_t *sbcast_cred;	/* job alloc info and sbcast cred */
+char *bcast_nodes;			/* nodes still receiving the file */
+
+typedef struct {
+	file_bcast_msg_t bcast_msg;	/* copy of the message for one block */
+	struct bcast_parameters *params;
+	int rc;
+	pthread_t thread;
+} bcast_block_t;
 
 static int   _bcast_file(struct bcast_parameters *params);
 static int   _file_bcast(struct bcast_parameters *params,
 			 file_bcast_msg_t *bcast_msg,
-			 job_sbcast_cred_msg_t *sbcast_cred);
+			 job_sbcast_cred_msg_t *sbcast_cred,
+			 hostlist_t *cached_hl);
 static int   _file_state(struct bcast_parameters *params);
 static List _fill_in_excluded_paths(struct bcast_parameters *params);
 static int _find_subpath(void *x, void *key);
@@ -163,10 +176,14 @@ static int _get_job_info(struct bcast_parameters *params)
 	return rc;
 }
 
-/* Issue the RPC to transfer the file's data */
+/*
+ * Issue the RPC to transfer the file's data
+ * OUT cached_hl - if set, nodes which already had the file in their cache
+ */
 static int _file_bcast(struct bcast_parameters *params,
 		       file_bcast_msg_t *bcast_msg,
-		       job_sbcast_cred_msg_t *sbcast_cred)
+		       job_sbcast_cred_msg_t *sbcast_cred,
+		       hostlist_t *cached_hl)
 {
 	List ret_list = NULL;
 	list_itr_t *itr;
@@ -181,8 +198,7 @@ static int _file_bcast(struct bcast_parameters *params,
 	msg.forward.tree_width = params->tree_width;
 	msg.msg_type = REQUEST_FILE_BCAST;
 
-	ret_list = slurm_send_recv_msgs(sbcast_cred->node_list, &msg,
-					params->timeout);
+	ret_list = slurm_send_recv_msgs(bcast_nodes, &msg, params->timeout);
 	if (ret_list == NULL) {
 		error("slurm_send_recv_msgs: %m");
 		exit(1);
@@ -194,6 +210,10 @@ static int _file_bcast(struct bcast_parameters *params,
 					       ret_data_info->data);
 		if (msg_rc == SLURM_SUCCESS)
 			continue;
+		if (cached_hl && (msg_rc == ESLURMD_FILE_BCAST_CACHED)) {
+			hostlist_push_host(cached_hl, ret_data_info->node_name);
+			continue;
+		}
 
 		error("REQUEST_FILE_BCAST(%s): %s",
 		      ret_data_info->node_name,
@@ -206,8 +226,34 @@ static int _file_bcast(struct bcast_parameters *params,
 	return rc;
 }
 
-/* load a buffer with data from the file to broadcast,
- * return number of bytes read, zero on end of file */
+/* Send one block while later blocks are being read and sent */
+static void *_file_bcast_block(void *arg)
+{
+	bcast_block_t *block = arg;
+
+	block->rc = _file_bcast(block->params, &block->bcast_msg, sbcast_cred,
+				NULL);
+	if (block->params->compress)
+		xfree(block->bcast_msg.block);
+
+	return NULL;
+}
+
+/* Wait for an in-flight block, return its result */
+static int _file_bcast_block_wait(bcast_block_t *block)
+{
+	int rc;
+
+	slurm_thread_join(block->thread);
+	rc = block->rc;
+	xfree(block);
+
+	return rc;
+}
+
+/* point buffer at the next block of the mmap'd file to broadcast, the data
+ * is packed straight from the mapping without an intermediate copy,
+ * return number of bytes in the block, zero on end of file */
 static int _get_block_none(char **buffer, int *orig_len, bool *more,
 			   bool file_start)
 {
@@ -221,13 +267,12 @@ static int _get_block_none(char **buffer, int *orig_len, bool *more,
 	}
 
 	if (remaining < 0) {
-		*buffer = xmalloc(block_len);
 		remaining = f_stat.st_size;
 		position = src;
 	}
 
 	size = MIN(block_len, remaining);
-	memcpy(*buffer, position, size);
+	*buffer = position;
 	remaining -= size;
 	position += size;
 
@@ -260,8 +305,9 @@ static int _get_block_lz4(struct bcast_parameters *params,
 	if (remaining < 0) {
 		position = src;
 		remaining = f_stat.st_size;
-		*buffer = xmalloc(block_len);
 	}
+	if (!*buffer)
+		*buffer = xmalloc(block_len);
 
 	/* intentionally limit decompressed size to 10x compressed
 	 * to avoid problems on receive size when decompressed */
@@ -305,6 +351,37 @@ static int _next_block(struct bcast_parameters *params,
 	return _get_block_none(buffer, orig_len, more, file_start);
 }
 
+/*
+ * Remove nodes which already had the file in their cache from bcast_nodes
+ * RET true if no node needs the rest of the file
+ */
+static bool _skip_cached_nodes(hostlist_t *cached_hl)
+{
+	hostlist_t *hl;
+	char *node;
+	bool done = false;
+
+	if (!hostlist_count(cached_hl))
+		return false;
+
+	hl = hostlist_create(bcast_nodes);
+	while ((node = hostlist_shift(cached_hl))) {
+		hostlist_delete_host(hl, node);
+		free(node);
+	}
+	if (!hostlist_count(hl)) {
+		verbose("file found in cache of all nodes");
+		done = true;
+	} else {
+		xfree(bcast_nodes);
+		bcast_nodes = hostlist_ranged_string_xmalloc(hl);
+		verbose("file not cached on nodes %s", bcast_nodes);
+	}
+	hostlist_destroy(hl);
+
+	return done;
+}
+
 /* read and broadcast the file */
 static int _bcast_file(struct bcast_parameters *params)
 {
@@ -315,6 +392,8 @@ static int _bcast_file(struct bcast_parameters *params)
 	uint64_t size_uncompressed = 0, size_compressed = 0;
 	uint32_t time_compression = 0;
 	bool more = true, file_start = true;
+	bcast_block_t *in_flight[PIPELINE_DEPTH] = { NULL };
+	int next_slot = 0;
 	DEF_TIMERS;
 
 	if (params->block_size)
@@ -344,6 +423,13 @@ static int _bcast_file(struct bcast_parameters *params)
 		bcast_msg.mtime     = f_stat.st_mtime;
 	}
 
+	/* Let nodes which already hold this content skip the transfer */
+	if ((f_stat.st_size > block_len) && bcast_cache_size())
+		bcast_msg.file_hash = bcast_file_hash(src, f_stat.st_size);
+
+	xfree(bcast_nodes);
+	bcast_nodes = xstrdup(sbcast_cred->node_list);
+
 	if (!params->tree_width)
 		params->tree_width = DEFAULT_THREADS;
 	else if (params->tree_width != 0xfffd)
@@ -366,7 +452,67 @@ static int _bcast_file(struct bcast_parameters *params)
 		if (!more)
 			bcast_msg.flags |= FILE_BCAST_LAST_BLOCK;
 
-		rc = _file_bcast(params, &bcast_msg, sbcast_cred);
+		if ((bcast_msg.block_no == 1) ||
+		    (bcast_msg.flags & FILE_BCAST_LAST_BLOCK)) {
+			/*
+			 * The first block creates the file and the last one
+			 * closes it, so every other block must have completed
+			 * before the last one is sent.
+			 */
+			for (int i = 0; i < PIPELINE_DEPTH; i++) {
+				int block_rc;
+
+				if (!in_flight[i])
+					continue;
+				block_rc = _file_bcast_block_wait(in_flight[i]);
+				in_flight[i] = NULL;
+				if (block_rc != SLURM_SUCCESS)
+					rc = block_rc;
+			}
+			if (rc != SLURM_SUCCESS)
+				break;
+			if (bcast_msg.file_hash) {
+				hostlist_t *cached_hl = hostlist_create(NULL);
+				bool done;
+
+				rc = _file_bcast(params, &bcast_msg,
+						 sbcast_cred, cached_hl);
+				done = _skip_cached_nodes(cached_hl);
+				hostlist_destroy(cached_hl);
+				xfree(bcast_msg.file_hash);
+				if (done)
+					break;
+			} else {
+				rc = _file_bcast(params, &bcast_msg,
+						 sbcast_cred, NULL);
+			}
+		} else {
+			/*
+			 * Keep up to PIPELINE_DEPTH blocks moving through the
+			 * forwarding tree at once. slurmd writes every block at
+			 * its own offset, so they may complete in any order.
+			 */
+			bcast_block_t *block;
+
+			if (in_flight[next_slot]) {
+				rc = _file_bcast_block_wait(
+					in_flight[next_slot]);
+				in_flight[next_slot] = NULL;
+			}
+			if (rc != SLURM_SUCCESS)
+				break;
+			block = xmalloc(sizeof(*block));
+			block->params = params;
+			memcpy(&block->bcast_msg, &bcast_msg,
+			       sizeof(bcast_msg));
+			slurm_thread_create(&block->thread, _file_bcast_block,
+					    block);
+			in_flight[next_slot] = block;
+			next_slot = (next_slot + 1) % PIPELINE_DEPTH;
+			/* the thread now owns a compressed block buffer */
+			if (params->compress)
+				buffer = NULL;
+		}
 		if (rc != SLURM_SUCCESS)
 			break;
 		if (bcast_msg.flags & FILE_BCAST_LAST_BLOCK)
@@ -374,8 +520,16 @@ static int _bcast_file(struct bcast_parameters *params)
 		bcast_msg.block_no++;
 		bcast_msg.block_offset += orig_len;
 	}
+	for (int i = 0; i < PIPELINE_DEPTH; i++) {
+		if (in_flight[i])
+			(void) _file_bcast_block_wait(in_flight[i]);
+	}
 	xfree(bcast_msg.user_name);
-	xfree(buffer);
+	xfree(bcast_msg.file_hash);
+	xfree(bcast_nodes);
+	/* uncompressed blocks point into the mmap'd file */
+	if (params->compress)
+		xfree(buffer);
 
 	if (size_uncompressed && (params->compress != 0)) {
 		int64_t pct = (int64_t) size_uncompressed - size_compressed;
@@ -659,6 +813,73 @@ extern int bcast_file(struct bcast_parameters *params)
 	return rc;
 }
 
+extern uint64_t bcast_cache_size(void)
+{
+	char *tmp, *end = NULL;
+	uint64_t size = 0;
+
+	if (!(tmp = conf_get_opt_str(slurm_conf.bcast_parameters,
+				     "CacheSize=")))
+		return 0;
+
+	size = strtoull(tmp, &end, 10);
+	if ((end == tmp) || (*end != '\0') || (size > (UINT64_MAX >> 20))) {
+		error("Invalid BcastParameters CacheSize=%s, file cache disabled",
+		      tmp);
+		size = 0;
+	}
+	xfree(tmp);
+
+	return (size << 20);
+}
+
+extern char *bcast_file_hash(void *data, uint64_t size)
+{
+	slurm_hash_t hash = { .type = HASH_PLUGIN_K12 };
+	char *hex = NULL;
+
+	if (!size)
+		return NULL;
+
+	if (size <= HASH_CHUNK_SIZE) {
+		if (hash_g_compute(data, size, NULL, 0, &hash) !=
+		    sizeof(hash.hash))
+			return NULL;
+	} else {
+		/*
+		 * hash_g_compute() takes an int length, so larger files are
+		 * hashed a chunk at a time and the hash of the chunk hashes
+		 * identifies the file.
+		 */
+		uint64_t chunks = ROUNDUP(size, HASH_CHUNK_SIZE);
+		size_t hash_len = sizeof(hash.hash);
+		char *hashes = xcalloc(chunks, hash_len);
+
+		for (uint64_t i = 0; i < chunks; i++) {
+			uint64_t offset = i * HASH_CHUNK_SIZE;
+			int len = MIN(size - offset, HASH_CHUNK_SIZE);
+
+			if (hash_g_compute((char *) data + offset, len, NULL, 0,
+					   &hash) != hash_len) {
+				xfree(hashes);
+				return NULL;
+			}
+			memcpy(&hashes[i * hash_len], hash.hash, hash_len);
+		}
+		if (hash_g_compute(hashes, (chunks * hash_len), NULL, 0,
+				   &hash) != hash_len) {
+			xfree(hashes);
+			return NULL;
+		}
+		xfree(hashes);
+	}
+
+	for (int i = 0; i < sizeof(hash.hash); i++)
+		xstrfmtcat(hex, "%02x", hash.hash[i]);
+
+	return hex;
+}
+
 extern int bcast_decompress_data(file_bcast_msg_t *req)
 {
 	switch (req->compress) {
@@ -63,6 +63,11 @@ struct bcast_parameters {
 typedef struct file_bcast_info {
 	void *data;		/* mmap of file data */
 	int fd;			/* file descriptor */
+	int cache_fd;		/* file descriptor of cache_tmp */
+	bool cache_failed;	/* could not write to cache_tmp */
+	char *cache_path;	/* content cache entry for this file */
+	char *cache_tmp;	/* cache entry being written */
+	char *file_hash;	/* hex hash of the whole file */
 	uint64_t file_size;	/* file size */
 	char *fname;		/* filename */
 	gid_t gid;		/* gid of owner */
@@ -86,4 +91,17 @@ extern int bcast_file(struct bcast_parameters *params);
 
 extern int bcast_decompress_data(file_bcast_msg_t *req);
 
+/*
+ * Size of the file cache on compute nodes set by BcastParameters=CacheSize=
+ * RET cache size in bytes, 0 if the cache is disabled
+ */
+extern uint64_t bcast_cache_size(void);
+
+/*
+ * Hash the contents of a file being broadcast
+ * RET hex string of the hash, must be xfreed, or NULL if the file is empty
+ *     or the hash plugin failed
+ */
+extern char *bcast_file_hash(void *data, uint64_t size);
+
 #endif
@@ -45,6 +45,7 @@
 #include <ctype.h>
 
 #include "src/common/uid.h"
+#include "src/common/xhash.h"
 #include "src/common/xstring.h"
 #include "src/interfaces/priority.h"
 #include "src/common/slurmdbd_pack.h"
@@ -89,6 +90,7 @@ static pthread_mutex_t assoc_lock_init = PTHREAD_MUTEX_INITIALIZER;
 static assoc_init_args_t init_setup;
 static slurmdb_assoc_rec_t **assoc_hash_id = NULL;
 static slurmdb_assoc_rec_t **assoc_hash = NULL;
+static xhash_t *user_uid_hash = NULL;
 static int *assoc_mgr_tres_old_pos = NULL;
 
 static bool _running_cache(void)
@@ -703,6 +705,66 @@ static int _list_find_user(void *x, void *key)
 	return 0;
 }
 
+static void _user_uid_hash_identify(void *item, const char **key,
+				    uint32_t *key_len)
+{
+	slurmdb_user_rec_t *user = item;
+
+	*key = (const char *) &user->uid;
+	*key_len = sizeof(user->uid);
+}
+
+static int _add_user_uid_hash(void *x, void *arg)
+{
+	slurmdb_user_rec_t *user = x;
+
+	/* Keep the first match to behave like list_find_first() */
+	if ((user->uid != NO_VAL) &&
+	    !xhash_get(user_uid_hash, (const char *) &user->uid,
+		       sizeof(user->uid)))
+		xhash_add(user_uid_hash, user);
+
+	return 0;
+}
+
+/*
+ * Rebuild the uid index into assoc_mgr_user_list. Must be called every time
+ * a record is added to or removed from the list or a uid changes.
+ * locks should be put in place before calling this function USER_WRITE
+ */
+static void _rebuild_user_uid_hash(void)
+{
+	xhash_free(user_uid_hash);
+
+	if (!assoc_mgr_user_list)
+		return;
+
+	user_uid_hash = xhash_init(_user_uid_hash_identify, NULL);
+	list_for_each(assoc_mgr_user_list, _add_user_uid_hash, NULL);
+}
+
+/* locks should be put in place before calling this function USER_READ */
+static slurmdb_user_rec_t *_find_user_by_uid(uint32_t uid)
+{
+	if (!assoc_mgr_user_list)
+		return NULL;
+
+	if ((uid == NO_VAL) || !user_uid_hash)
+		return list_find_first_ro(assoc_mgr_user_list,
+					  _list_find_uid, &uid);
+
+	return xhash_get(user_uid_hash, (const char *) &uid, sizeof(uid));
+}
+
+/* locks should be put in place before calling this function USER_READ */
+static slurmdb_user_rec_t *_find_user(slurmdb_user_rec_t *user)
+{
+	if (user->uid != NO_VAL)
+		return _find_user_by_uid(user->uid);
+
+	return list_find_first_ro(assoc_mgr_user_list, _list_find_user, user);
+}
+
 static int _list_find_coord(void *x, void *key)
 {
 	slurmdb_user_rec_t *user = x;
@@ -736,8 +798,7 @@ static void _set_user_default_acct(slurmdb_assoc_rec_t *assoc,
 	/* set up the default if this is it */
 	if ((assoc->is_def == 1) && (assoc->uid != NO_VAL)) {
 		if (!user)
-			user = list_find_first(assoc_mgr_user_list,
-					       _list_find_uid, &assoc->uid);
+			user = _find_user_by_uid(assoc->uid);
 
 		if (!user)
 			return;
@@ -767,8 +828,7 @@ static void _clear_user_default_acct(slurmdb_assoc_rec_t *assoc)
 
 	/* set up the default if this is it */
 	if ((assoc->is_def == 0) && (assoc->uid != NO_VAL)) {
-		slurmdb_user_rec_t *user = list_find_first(
-			assoc_mgr_user_list, _list_find_uid, &assoc->uid);
+		slurmdb_user_rec_t *user = _find_user_by_uid(assoc->uid);
 
 		if (!user)
 			return;
@@ -795,8 +855,7 @@ static void _set_user_default_wckey(slurmdb_wckey_rec_t *wckey,
 	/* set up the default if this is it */
 	if ((wckey->is_def == 1) && (wckey->uid != NO_VAL)) {
 		if (!user)
-			user = list_find_first(assoc_mgr_user_list,
-					       _list_find_uid, &wckey->uid);
+			user = _find_user_by_uid(wckey->uid);
 
 		if (!user)
 			return;
@@ -1761,6 +1820,7 @@ static int _get_assoc_mgr_user_list(void *db_conn, int enforce)
 	}
 
 	_post_user_list(assoc_mgr_user_list);
+	_rebuild_user_uid_hash();
 
 	assoc_mgr_unlock(&locks);
 	return SLURM_SUCCESS;
@@ -2013,6 +2073,7 @@ static int _refresh_assoc_mgr_user_list(void *db_conn, int enforce)
 	FREE_NULL_LIST(assoc_mgr_user_list);
 
 	assoc_mgr_user_list = current_users;
+	_rebuild_user_uid_hash();
 
 	assoc_mgr_unlock(&locks);
 
@@ -2179,6 +2240,7 @@ extern int assoc_mgr_fini(bool save_state)
 
 	xfree(assoc_hash_id);
 	xfree(assoc_hash);
+	xhash_free(user_uid_hash);
 
 	assoc_mgr_unlock(&locks);
 
@@ -2208,8 +2270,7 @@ static slurmdb_admin_level_t _get_admin_level_internal(void *db_conn,
 		return SLURMDB_ADMIN_NOTSET;
 	}
 
-	found_user = list_find_first_ro(assoc_mgr_user_list,
-					_list_find_uid, &uid);
+	found_user = _find_user_by_uid(uid);
 
 	if (found_user)
 		level = found_user->admin_level;
@@ -2874,8 +2935,7 @@ extern int assoc_mgr_fill_in_user(void *db_conn, slurmdb_user_rec_t *user,
 		return SLURM_SUCCESS;
 	}
 
-	if (!(found_user = list_find_first_ro(assoc_mgr_user_list,
-					      _list_find_user, user))) {
+	if (!(found_user = _find_user(user))) {
 		if (!locked)
 			assoc_mgr_unlock(&locks);
 		if (enforce & ACCOUNTING_ENFORCE_ASSOCS)
@@ -4727,6 +4787,7 @@ extern int assoc_mgr_update_users(slurmdb_update_object_t *update, bool locked)
 		slurmdb_destroy_user_rec(object);
 	}
 	list_iterator_destroy(itr);
+	_rebuild_user_uid_hash();
 	if (!locked)
 		assoc_mgr_unlock(&locks);
 
@@ -6396,6 +6457,7 @@ extern int load_assoc_mgr_state(bool only_tres)
 			FREE_NULL_LIST(assoc_mgr_user_list);
 			assoc_mgr_user_list = msg->my_list;
 			_post_user_list(assoc_mgr_user_list);
+			_rebuild_user_uid_hash();
 			debug("Recovered %u users",
 			      list_count(assoc_mgr_user_list));
 			msg->my_list = NULL;
@@ -6590,7 +6652,7 @@ extern void assoc_mgr_set_uid(uid_t uid, char *username)
 		return;
 	}
 
-	if (list_find_first_ro(assoc_mgr_user_list, _list_find_uid, &uid)) {
+	if (_find_user_by_uid(uid)) {
 		debug2("%s: uid=%u already known", __func__, uid);
 		assoc_mgr_unlock(&read_lock);
 		return;
@@ -6615,6 +6677,7 @@ extern void assoc_mgr_set_uid(uid_t uid, char *username)
 	debug2("%s: adding mapping for user %s uid %u",
 	       __func__, username, uid);
 	user->uid = uid;
+	_rebuild_user_uid_hash();
 
 	if (assoc_mgr_assoc_list)
 		list_for_each(assoc_mgr_assoc_list, _each_assoc_set_uid, user);
@@ -6708,6 +6771,7 @@ extern int assoc_mgr_set_missing_uids(void)
 	if (assoc_mgr_user_list) {
 		list_for_each(assoc_mgr_user_list,
 			      _for_each_user_missing_uids, NULL);
+		_rebuild_user_uid_hash();
 	}
 	assoc_mgr_unlock(&locks);
 
@@ -61,6 +61,11 @@ struct elem {
 	int curr_max_children;
 	char *key;
 	char *value;
+	/* value converted once when parsed, for comparison to node data */
+	bool value_bool;
+	bool value_bool_valid;
+	double value_float;
+	bool value_float_valid;
 };
 
 /*
@@ -56,9 +56,28 @@
 #include "src/common/xmalloc.h"
 #include "src/common/xstring.h"
 
+/*
+ * Remember nodes which recently failed to relay a message so they are not
+ * picked as the head of a new subtree, where a slow or dead forwarder would
+ * hold up every node below it until the message times out.
+ */
+#define FWD_FAIL_CNT	64	/* size of forwarding failure history */
+#define FWD_FAIL_TIME	300	/* seconds to avoid a failed forwarder */
+#define FWD_FAIL_SCAN	16	/* hosts to examine for a new subtree head */
+
+typedef struct {
+	char *name;
+	time_t fail_time;
+} fwd_fail_t;
+
 static slurm_node_alias_addrs_t *last_alias_addrs = NULL;
 static pthread_mutex_t alias_addrs_mutex = PTHREAD_MUTEX_INITIALIZER;
 
+static fwd_fail_t fwd_fail[FWD_FAIL_CNT];
+static int fwd_fail_next = 0;
+static int fwd_fail_used = 0;
+static pthread_mutex_t fwd_fail_mutex = PTHREAD_MUTEX_INITIALIZER;
+
 typedef struct {
 	pthread_cond_t *notify;
 	int            *p_thr_count;
@@ -77,6 +96,104 @@ static void _forward_msg_internal(hostlist_t *hl, hostlist_t **sp_hl,
 				  header_t *header, int timeout,
 				  int hl_count);
 
+/* Return index of name in fwd_fail or -1. Call with fwd_fail_mutex locked */
+static int _fwd_fail_find(const char *name)
+{
+	for (int i = 0; i < fwd_fail_used; i++) {
+		if (!xstrcmp(fwd_fail[i].name, name))
+			return i;
+	}
+	return -1;
+}
+
+/* Record whether the node "name" was able to relay a forwarded message */
+static void _fwd_fail_record(const char *name, bool failed)
+{
+	int i;
+
+	slurm_mutex_lock(&fwd_fail_mutex);
+	if (!failed && !fwd_fail_used) {
+		slurm_mutex_unlock(&fwd_fail_mutex);
+		return;
+	}
+
+	i = _fwd_fail_find(name);
+	if (failed) {
+		if (i < 0) {
+			i = fwd_fail_next;
+			fwd_fail_next = (fwd_fail_next + 1) % FWD_FAIL_CNT;
+			if (fwd_fail_used < FWD_FAIL_CNT)
+				fwd_fail_used++;
+			xfree(fwd_fail[i].name);
+			fwd_fail[i].name = xstrdup(name);
+		}
+		fwd_fail[i].fail_time = time(NULL);
+	} else if (i >= 0) {
+		fwd_fail[i].fail_time = 0;
+	}
+	slurm_mutex_unlock(&fwd_fail_mutex);
+}
+
+/* Test if name recently failed to relay. Call with fwd_fail_mutex locked */
+static bool _fwd_fail_recent(const char *name, time_t now)
+{
+	int i = _fwd_fail_find(name);
+
+	if ((i < 0) || !fwd_fail[i].fail_time)
+		return false;
+	return (difftime(now, fwd_fail[i].fail_time) < FWD_FAIL_TIME);
+}
+
+/*
+ * Pick the head of a subtree. The first host of hl is the node the message is
+ * sent to and which relays it to the rest of hl. If that host recently failed
+ * to relay, move the first responsive host of hl to the front instead.
+ * RET hl or a reordered replacement (hl is then destroyed)
+ */
+static hostlist_t *_fwd_pick_head(hostlist_t *hl)
+{
+	hostlist_t *new_hl;
+	time_t now = time(NULL);
+	char *name = NULL;
+	int cnt, i;
+
+	if ((cnt = hostlist_count(hl)) < 2)
+		return hl;
+
+	slurm_mutex_lock(&fwd_fail_mutex);
+	if (!fwd_fail_used) {
+		slurm_mutex_unlock(&fwd_fail_mutex);
+		return hl;
+	}
+	cnt = MIN(cnt, FWD_FAIL_SCAN);
+	for (i = 0; i < cnt; i++) {
+		bool recent;
+
+		name = hostlist_nth(hl, i);
+		recent = _fwd_fail_recent(name, now);
+		if (!recent)
+			break;
+		free(name);
+	}
+	slurm_mutex_unlock(&fwd_fail_mutex);
+
+	if (!i || (i >= cnt)) {
+		if (!i)
+			free(name);
+		return hl;
+	}
+
+	debug2("%s: using %s as forwarder in place of %d recently failed node(s)",
+	       __func__, name, i);
+	new_hl = hostlist_create(name);
+	free(name);
+	hostlist_delete_nth(hl, i);
+	hostlist_push_list(new_hl, hl);
+	hostlist_destroy(hl);
+
+	return new_hl;
+}
+
 void _destroy_tree_fwd(fwd_tree_t *fwd_tree)
 {
 	if (fwd_tree) {
@@ -144,6 +261,7 @@ static void *_forward_thread(void *arg)
 			error("%s: failed to %s (%pA): %m",
 			      __func__, name, &addr);
 
+			_fwd_fail_record(name, true);
 			slurm_mutex_lock(&fwd_struct->forward_mutex);
 			mark_as_failed_forward(
 				&fwd_struct->ret_list, name,
@@ -208,6 +326,7 @@ static void *_forward_thread(void *arg)
 				     get_buf_offset(buffer)) < 0) {
 			error("%s: slurm_msg_sendto: %m", __func__);
 
+			_fwd_fail_record(name, true);
 			slurm_mutex_lock(&fwd_struct->forward_mutex);
 			mark_as_failed_forward(&fwd_struct->ret_list, name,
 					       errno);
@@ -273,6 +392,7 @@ static void *_forward_thread(void *arg)
 
 		if (!ret_list || (fwd_msg->header.forward.cnt != 0
 				  && list_count(ret_list) <= 1)) {
+			_fwd_fail_record(name, true);
 			slurm_mutex_lock(&fwd_struct->forward_mutex);
 			mark_as_failed_forward(&fwd_struct->ret_list, name,
 					       errno);
@@ -330,6 +450,7 @@ static void *_forward_thread(void *arg)
 				free(tmp);
 			}
 			hostlist_iterator_destroy(host_itr);
+			_fwd_fail_record(name, true);
 			if (!first_node_found) {
 				slurm_mutex_lock(&fwd_struct->forward_mutex);
 				mark_as_failed_forward(
@@ -339,6 +460,8 @@ static void *_forward_thread(void *arg)
 				slurm_mutex_unlock(&fwd_struct->forward_mutex);
 			}
 		}
+		if (fwd_msg->header.forward.cnt + 1 == list_count(ret_list))
+			_fwd_fail_record(name, false);
 		break;
 	}
 	slurm_mutex_lock(&fwd_struct->forward_mutex);
@@ -491,6 +614,8 @@ static void *_fwd_tree_thread(void *arg)
 			FREE_NULL_LIST(ret_list);
 			/* try next node */
 			if (ret_cnt <= send_msg.forward.cnt) {
+				if (send_msg.forward.cnt)
+					_fwd_fail_record(name, true);
 				free(name);
 				/* Abandon tree. This way if all the
 				 * nodes in the branch are down we
@@ -520,12 +645,15 @@ static void *_fwd_tree_thread(void *arg)
 			continue;
 		}
 
-		free(name);
-
 		/* check for error and try again */
-		if (errno == SLURM_COMMUNICATIONS_CONNECTION_ERROR)
+		if (errno == SLURM_COMMUNICATIONS_CONNECTION_ERROR) {
+			free(name);
  			continue;
+		}
 
+		if (send_msg.forward.cnt)
+			_fwd_fail_record(name, false);
+		free(name);
 		break;
 	}
 
@@ -560,7 +688,7 @@ static void _start_msg_tree_internal(hostlist_t *hl, hostlist_t **sp_hl,
 		memcpy(fwd_tree, fwd_tree_in, sizeof(fwd_tree_t));
 
 		if (sp_hl) {
-			fwd_tree->tree_hl = sp_hl[j];
+			fwd_tree->tree_hl = _fwd_pick_head(sp_hl[j]);
 			sp_hl[j] = NULL;
 		} else if (hl) {
 			char *name = hostlist_shift(hl);
@@ -615,6 +743,7 @@ static void _forward_msg_internal(hostlist_t *hl, hostlist_t **sp_hl,
 		fwd_msg->header.ret_cnt = 0;
 
 		if (sp_hl) {
+			sp_hl[j] = _fwd_pick_head(sp_hl[j]);
 			buf = hostlist_ranged_string_xmalloc(sp_hl[j]);
 			hostlist_destroy(sp_hl[j]);
 		} else {
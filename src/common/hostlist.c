@@ -2151,6 +2151,26 @@ int hostlist_count(hostlist_t *hl)
 	return retval;
 }
 
+int hostlist_for_each_range(hostlist_t *hl, hostlist_range_f f, void *arg)
+{
+	int i, rc = 0;
+
+	if (!hl)
+		return -1;
+
+	LOCK_HOSTLIST(hl);
+	for (i = 0; i < hl->nranges; i++) {
+		hostrange_t *hr = hl->hr[i];
+
+		if ((rc = f(hr->prefix, hr->lo, hr->hi, hr->width,
+			    hr->singlehost, arg)))
+			break;
+	}
+	UNLOCK_HOSTLIST(hl);
+
+	return rc;
+}
+
 int hostlist_find_dims(hostlist_t *hl, const char *hostname, int dims)
 {
 	int i, count, ret = -1;
@@ -2328,10 +2348,23 @@ void hostlist_uniq(hostlist_t *hl)
 	}
 	qsort(hl->hr, hl->nranges, sizeof(hostrange_t *), &_cmp);
 
-	while (i < hl->nranges) {
-		if (_attempt_range_join(hl, i) < 0) /* No range join occurred */
-			i++;
+	/*
+	 * Join each range into the last kept one and compact the array in a
+	 * single pass rather than shifting it down on every join.
+	 */
+	for (int j = 1; j < hl->nranges; j++) {
+		int ndup = hostrange_join(hl->hr[i - 1], hl->hr[j]);
+
+		if (ndup >= 0) {
+			hostrange_destroy(hl->hr[j]);
+			hl->nhosts -= ndup;
+		} else {
+			hl->hr[i++] = hl->hr[j];
+		}
 	}
+	for (int j = i; j < hl->nranges; j++)
+		hl->hr[j] = NULL;
+	hl->nranges = i;
 
 	/* reset all iterators */
 	for (hli = hl->ilist; hli; hli = hli->next)
@@ -3194,7 +3227,7 @@ void hostset_destroy(hostset_t *set)
  */
 static int hostset_insert_range(hostset_t *set, hostrange_t *hr)
 {
-	int i = 0;
+	int i = 0, high;
 	int inserted = 0;
 	int nhosts = 0;
 	int ndups = 0;
@@ -3207,26 +3240,48 @@ static int hostset_insert_range(hostset_t *set, hostrange_t *hr)
 
 	nhosts = hostrange_count(hr);
 
-	for (i = 0; i < hl->nranges; i++) {
-		if (hostrange_cmp(hr, hl->hr[i]) <= 0) {
+	/*
+	 * The ranges of a hostset are kept sorted, so binary search for the
+	 * first range that hr sorts before or equal to. hostrange_cmp() is
+	 * only a total order (and leaves the widths alone) among ranges of
+	 * the same width, so fall back to a linear scan if a range with the
+	 * same prefix but another width turns up.
+	 */
+	high = hl->nranges;
+	while (i < high) {
+		int mid = (i + high) / 2;
+
+		if (!hostrange_prefix_cmp(hr, hl->hr[mid]) &&
+		    (hr->width != hl->hr[mid]->width)) {
+			for (i = 0; i < hl->nranges; i++) {
+				if (hostrange_cmp(hr, hl->hr[i]) <= 0)
+					break;
+			}
+			break;
+		}
 
-			if ((ndups = hostrange_join(hr, hl->hr[i])) >= 0)
-				hostlist_delete_range(hl, i);
-			else if (ndups < 0)
-				ndups = 0;
+		if (hostrange_cmp(hr, hl->hr[mid]) <= 0)
+			high = mid;
+		else
+			i = mid + 1;
+	}
 
-			hostlist_insert_range(hl, hr, i);
+	if (i < hl->nranges) {
+		if ((ndups = hostrange_join(hr, hl->hr[i])) >= 0)
+			hostlist_delete_range(hl, i);
+		else if (ndups < 0)
+			ndups = 0;
 
-			/* now attempt to join hr[i] and hr[i-1] */
-			if (i > 0) {
-				int m;
-				if ((m = _attempt_range_join(hl, i)) > 0)
-					ndups += m;
-			}
-			hl->nhosts += nhosts - ndups;
-			inserted = 1;
-			break;
+		hostlist_insert_range(hl, hr, i);
+
+		/* now attempt to join hr[i] and hr[i-1] */
+		if (i > 0) {
+			int m;
+			if ((m = _attempt_range_join(hl, i)) > 0)
+				ndups += m;
 		}
+		hl->nhosts += nhosts - ndups;
+		inserted = 1;
 	}
 
 	if (inserted == 0) {
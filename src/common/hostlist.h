@@ -41,6 +41,7 @@
 
 #include "config.h"
 
+#include <stdbool.h>
 #include <unistd.h>		/* load ssize_t definition */
 
 /* Since users can specify a numeric range in the prefix, we need to prevent
@@ -269,6 +270,23 @@ int hostlist_delete_nth(hostlist_t *hl, int n);
  */
 int hostlist_count(hostlist_t *hl);
 
+/* hostlist_for_each_range():
+ *
+ * Call f() for each range of hosts in hostlist hl without expanding them
+ * into individual hostnames. For a single host, prefix is the full hostname
+ * and lo, hi and width are not valid. Otherwise the range contains the hosts
+ * formatted as "%s%0*lu" (prefix, width, n) for n in [lo, hi]. Ranges of
+ * multi-dimensional hostlists are encoded and must not be formatted this way.
+ * The hostlist is locked while f() runs, so f() must not modify it.
+ *
+ * Iteration stops when f() returns non-zero, which is then returned.
+ * Returns 0 once all ranges have been visited or -1 if hl is NULL.
+ */
+typedef int (*hostlist_range_f)(const char *prefix, unsigned long lo,
+				unsigned long hi, int width, bool single,
+				void *arg);
+int hostlist_for_each_range(hostlist_t *hl, hostlist_range_f f, void *arg);
+
 /* hostlist_is_empty(): return true if hostlist is empty. */
 #define hostlist_is_empty(__hl) ( hostlist_count(__hl) == 0 )
 
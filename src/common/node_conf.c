@@ -49,6 +49,7 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <inttypes.h>
+#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -63,6 +64,7 @@
 #include "src/common/pack.h"
 #include "src/common/parse_time.h"
 #include "src/common/read_config.h"
+#include "src/common/working_cluster.h"
 #include "src/interfaces/select.h"
 #include "src/interfaces/accounting_storage.h"
 #include "src/interfaces/acct_gather_energy.h"
@@ -97,6 +99,37 @@ uint16_t *cr_node_num_cores = NULL;
 uint32_t *cr_node_cores_offset = NULL;
 bool spec_cores_first = false;
 
+/*
+ * Index of node names ending in a number, keyed by the name prefix. Used to
+ * resolve hostlist ranges to node records without formatting and hashing
+ * each hostname in the range. Rebuilt with node_hash_table in rehash_node().
+ * Entries are validated against node_record_table_ptr before use, so nodes
+ * added or removed since the last rebuild just fall back to the hash lookup.
+ */
+typedef struct {
+	uint16_t digits;	/* length of numeric suffix in name */
+	int index;		/* node_record_table_ptr index */
+	bool lead_zero;		/* numeric suffix is zero padded */
+	node_record_t *node_ptr;
+	unsigned long num;	/* numeric suffix value */
+} node_suffix_t;
+
+typedef struct {
+	int cnt;
+	node_suffix_t *entries;	/* sorted by num */
+	char *prefix;
+	int size;
+} node_prefix_t;
+
+typedef struct {
+	bool best_effort;
+	bitstr_t *bitmap;
+	bool from_hostlist;	/* called by hostlist2bitmap() */
+	int rc;
+} range2bitmap_args_t;
+
+static xhash_t *node_prefix_table = NULL;
+
 /* Local function definitions */
 static void _delete_config_record(void);
 static void _delete_node_config_ptr(node_record_t *node_ptr);
@@ -181,6 +214,245 @@ static void _node_record_hash_identity (void* item, const char** key,
 	*key_len = strlen(node_ptr->name);
 }
 
+/*
+ * Split a node name into prefix and numeric suffix the way hostlist does.
+ * RET false if the name does not end in a usable number
+ */
+static bool _parse_node_suffix(const char *name, int *prefix_len,
+			       node_suffix_t *suffix)
+{
+	int len = strlen(name), i = len;
+
+	while ((i > 0) && isdigit((unsigned char) name[i - 1]))
+		i--;
+
+	/* no suffix or too long to fit in an unsigned long */
+	if ((i == len) || ((len - i) > 18))
+		return false;
+
+	*prefix_len = i;
+	suffix->digits = len - i;
+	suffix->lead_zero = ((name[i] == '0') && (suffix->digits > 1));
+	suffix->num = strtoul(name + i, NULL, 10);
+
+	return true;
+}
+
+static void _node_prefix_identity(void *item, const char **key,
+				  uint32_t *key_len)
+{
+	node_prefix_t *prefix_ptr = item;
+
+	*key = prefix_ptr->prefix;
+	*key_len = strlen(prefix_ptr->prefix);
+}
+
+static void _node_prefix_free(void *item)
+{
+	node_prefix_t *prefix_ptr = item;
+
+	xfree(prefix_ptr->entries);
+	xfree(prefix_ptr->prefix);
+	xfree(prefix_ptr);
+}
+
+static int _cmp_node_suffix(const void *x, const void *y)
+{
+	const node_suffix_t *a = x, *b = y;
+
+	if (a->num < b->num)
+		return -1;
+	if (a->num > b->num)
+		return 1;
+	return 0;
+}
+
+static void _sort_node_prefix(void *item, void *arg)
+{
+	node_prefix_t *prefix_ptr = item;
+
+	qsort(prefix_ptr->entries, prefix_ptr->cnt, sizeof(node_suffix_t),
+	      _cmp_node_suffix);
+}
+
+static void _rebuild_node_prefix_table(void)
+{
+	node_record_t *node_ptr;
+	node_prefix_t *prefix_ptr;
+	node_suffix_t suffix;
+	int prefix_len;
+
+	xhash_free(node_prefix_table);
+	node_prefix_table = xhash_init(_node_prefix_identity,
+				       _node_prefix_free);
+
+	for (int i = 0; (node_ptr = next_node(&i)); i++) {
+		if (!node_ptr->name ||
+		    !_parse_node_suffix(node_ptr->name, &prefix_len, &suffix))
+			continue;
+
+		prefix_ptr = xhash_get(node_prefix_table, node_ptr->name,
+				       prefix_len);
+		if (!prefix_ptr) {
+			prefix_ptr = xmalloc(sizeof(*prefix_ptr));
+			prefix_ptr->prefix = xstrndup(node_ptr->name,
+						      prefix_len);
+			xhash_add(node_prefix_table, prefix_ptr);
+		}
+		if (prefix_ptr->cnt >= prefix_ptr->size) {
+			prefix_ptr->size = MAX(16, prefix_ptr->size * 2);
+			xrecalloc(prefix_ptr->entries, prefix_ptr->size,
+				  sizeof(node_suffix_t));
+		}
+		suffix.index = node_ptr->index;
+		suffix.node_ptr = node_ptr;
+		prefix_ptr->entries[prefix_ptr->cnt++] = suffix;
+	}
+
+	xhash_walk(node_prefix_table, _sort_node_prefix, NULL);
+}
+
+/*
+ * Test if the node named by this index entry is still in the node table and
+ * is named prefix followed by num zero padded to width.
+ */
+static node_record_t *_node_suffix_match(node_prefix_t *prefix_ptr,
+					 node_suffix_t *entry, int width)
+{
+	node_record_t *node_ptr;
+	node_suffix_t suffix;
+	int prefix_len;
+
+	/* printf("%0*lu") pads up to width but never truncates */
+	if ((entry->digits < width) ||
+	    ((entry->digits > width) && entry->lead_zero))
+		return NULL;
+
+	if ((entry->index >= node_record_count) ||
+	    (node_record_table_ptr[entry->index] != entry->node_ptr))
+		return NULL;
+
+	node_ptr = entry->node_ptr;
+	if (!node_ptr->name ||
+	    !_parse_node_suffix(node_ptr->name, &prefix_len, &suffix) ||
+	    (suffix.num != entry->num) || (suffix.digits != entry->digits) ||
+	    (prefix_len != strlen(prefix_ptr->prefix)) ||
+	    strncmp(node_ptr->name, prefix_ptr->prefix, prefix_len))
+		return NULL;
+
+	return node_ptr;
+}
+
+static void _name2bitmap(char *name, range2bitmap_args_t *args)
+{
+	node_record_t *node_ptr;
+
+	if ((node_ptr = _find_node_record(name, args->best_effort, true))) {
+		bit_set(args->bitmap, node_ptr->index);
+	} else {
+		if (args->from_hostlist)
+			error("hostlist2bitmap: invalid node specified %s",
+			      name);
+		else
+			error("node_name2bitmap: invalid node specified: \"%s\"",
+			      name);
+		if (!args->best_effort)
+			args->rc = EINVAL;
+	}
+}
+
+/* hostlist_for_each_range() callback, set bits for each node in range */
+static int _range2bitmap(const char *prefix, unsigned long lo,
+			 unsigned long hi, int width, bool single, void *arg)
+{
+	range2bitmap_args_t *args = arg;
+	node_prefix_t *prefix_ptr = NULL;
+	node_record_t *node_ptr;
+	char *name;
+	size_t size;
+	int i = 0, j;
+
+	if (single) {
+		_name2bitmap((char *) prefix, args);
+		return 0;
+	}
+
+	if (node_prefix_table)
+		prefix_ptr = xhash_get_str(node_prefix_table, prefix);
+	if (prefix_ptr) {
+		/* first entry with num >= lo */
+		int high = prefix_ptr->cnt;
+		while (i < high) {
+			int mid = (i + high) / 2;
+			if (prefix_ptr->entries[mid].num < lo)
+				i = mid + 1;
+			else
+				high = mid;
+		}
+	}
+
+	size = strlen(prefix) + width + 24;
+	name = xmalloc(size);
+	for (unsigned long n = lo; n <= hi; n++) {
+		node_ptr = NULL;
+		if (prefix_ptr) {
+			while ((i < prefix_ptr->cnt) &&
+			       (prefix_ptr->entries[i].num < n))
+				i++;
+			for (j = i; !node_ptr && (j < prefix_ptr->cnt) &&
+			     (prefix_ptr->entries[j].num == n); j++)
+				node_ptr = _node_suffix_match(
+					prefix_ptr, &prefix_ptr->entries[j],
+					width);
+		}
+
+		if (node_ptr) {
+			bit_set(args->bitmap, node_ptr->index);
+		} else {
+			snprintf(name, size, "%s%0*lu", prefix, width, n);
+			_name2bitmap(name, args);
+		}
+
+		if (n == ULONG_MAX)
+			break;
+	}
+	xfree(name);
+
+	return 0;
+}
+
+/*
+ * Set the bits for each host in hl, resolving ranges through
+ * node_prefix_table where possible.
+ */
+static int _hostlist2bitmap(hostlist_t *hl, bool best_effort,
+			    bitstr_t *bitmap, bool from_hostlist)
+{
+	range2bitmap_args_t args = {
+		.best_effort = best_effort,
+		.bitmap = bitmap,
+		.from_hostlist = from_hostlist,
+		.rc = SLURM_SUCCESS,
+	};
+	hostlist_iterator_t *hi;
+	char *name;
+
+	if (slurmdb_setup_cluster_dims() == 1) {
+		hostlist_for_each_range(hl, _range2bitmap, &args);
+		return args.rc;
+	}
+
+	/* multi-dimensional suffixes are not plain numbers */
+	hi = hostlist_iterator_create(hl);
+	while ((name = hostlist_next(hi))) {
+		_name2bitmap(name, &args);
+		free(name);
+	}
+	hostlist_iterator_destroy(hi);
+
+	return args.rc;
+}
+
 /*
  * bitmap2hostlist - given a bitmap, build a hostlist
  * IN bitmap - bitmap pointer
@@ -1109,6 +1381,7 @@ extern void init_node_conf(void)
 	last_node_index = -1;
 	xfree(node_record_table_ptr);
 	xhash_free(node_hash_table);
+	xhash_free(node_prefix_table);
 
 	if (config_list)	/* delete defunct configuration entries */
 		_delete_config_record();
@@ -1130,6 +1403,7 @@ extern void node_fini2 (void)
 	node_record_t *node_ptr;
 
 	xhash_free(node_hash_table);
+	xhash_free(node_prefix_table);
 	for (i = 0; (node_ptr = next_node(&i)); i++)
 		delete_node_record(node_ptr);
 
@@ -1178,7 +1452,6 @@ extern int node_name2bitmap (char *node_names, bool best_effort,
 			     bitstr_t **bitmap)
 {
 	int rc = SLURM_SUCCESS;
-	char *this_node_name;
 	bitstr_t *my_bitmap;
 	hostlist_t *host_list;
 
@@ -1198,19 +1471,7 @@ extern int node_name2bitmap (char *node_names, bool best_effort,
 		return rc;
 	}
 
-	while ( (this_node_name = hostlist_shift (host_list)) ) {
-		node_record_t *node_ptr;
-		node_ptr = _find_node_record(this_node_name, best_effort, true);
-		if (node_ptr) {
-			bit_set(my_bitmap, node_ptr->index);
-		} else {
-			error("%s: invalid node specified: \"%s\"", __func__,
-			      this_node_name);
-			if (!best_effort)
-				rc = EINVAL;
-		}
-		free (this_node_name);
-	}
+	rc = _hostlist2bitmap(host_list, best_effort, my_bitmap, false);
 	hostlist_destroy (host_list);
 
 	return rc;
@@ -1225,33 +1486,10 @@ extern int node_name2bitmap (char *node_names, bool best_effort,
  */
 extern int hostlist2bitmap(hostlist_t *hl, bool best_effort, bitstr_t **bitmap)
 {
-	int rc = SLURM_SUCCESS;
-	bitstr_t *my_bitmap;
-	char *name;
-	hostlist_iterator_t *hi;
-
 	FREE_NULL_BITMAP(*bitmap);
-	my_bitmap = (bitstr_t *) bit_alloc (node_record_count);
-	*bitmap = my_bitmap;
-
-	hi = hostlist_iterator_create(hl);
-	while ((name = hostlist_next(hi))) {
-		node_record_t *node_ptr;
-		node_ptr = _find_node_record(name, best_effort, true);
-		if (node_ptr) {
-			bit_set(my_bitmap, node_ptr->index);
-		} else {
-			error ("hostlist2bitmap: invalid node specified %s",
-			       name);
-			if (!best_effort)
-				rc = EINVAL;
-		}
-		free (name);
-	}
-
-	hostlist_iterator_destroy(hi);
-	return rc;
+	*bitmap = bit_alloc(node_record_count);
 
+	return _hostlist2bitmap(hl, best_effort, *bitmap, true);
 }
 
 /* Only delete config_ptr if isn't referenced by another node. */
@@ -1333,6 +1571,7 @@ extern void rehash_node (void)
 			continue;	/* vestigial record */
 		xhash_add(node_hash_table, node_ptr);
 	}
+	_rebuild_node_prefix_table();
 
 #if _DEBUG
 	_dump_hash();
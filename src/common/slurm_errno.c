@@ -533,6 +533,8 @@ slurm_errtab_t slurm_errtab[] = {
 	  "Unable to satisfy cpu bind request"			},
 	{ ERRTAB_ENTRY(ESLURMD_CPU_LAYOUT_ERROR),
 	  "Unable to layout tasks on given cpus"		},
+	{ ERRTAB_ENTRY(ESLURMD_FILE_BCAST_CACHED),
+	  "File broadcast satisfied from node cache"		},
 
 	/* socket specific Slurm communications error */
 
@@ -5107,6 +5107,7 @@ extern void slurm_free_file_bcast_msg(file_bcast_msg_t *msg)
 		xfree(msg->block);
 		xfree(msg->fname);
 		xfree(msg->exe_fname);
+		xfree(msg->file_hash);
 		xfree(msg->user_name);
 		delete_sbcast_cred(msg->cred);
 		xfree(msg);
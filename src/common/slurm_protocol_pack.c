@@ -8428,6 +8428,7 @@ static void _pack_file_bcast(file_bcast_msg_t * msg , buf_t *buffer,
 
 		packstr(msg->fname, buffer);
 		packstr(msg->exe_fname, buffer);
+		packstr(msg->file_hash, buffer);
 		pack32(msg->block_len, buffer);
 		pack32(msg->uncomp_len, buffer);
 		pack64(msg->block_offset, buffer);
@@ -8483,6 +8484,7 @@ static int _unpack_file_bcast(file_bcast_msg_t ** msg_ptr , buf_t *buffer,
 
 		safe_unpackstr(&msg->fname, buffer);
 		safe_unpackstr(&msg->exe_fname, buffer);
+		safe_unpackstr(&msg->file_hash, buffer);
 		safe_unpack32(&msg->block_len, buffer);
 		safe_unpack32(&msg->uncomp_len, buffer);
 		safe_unpack64(&msg->block_offset, buffer);
@@ -60,10 +60,19 @@ typedef struct {
     char *username;
 } uid_cache_entry_t;
 
+typedef struct {
+    gid_t gid;
+    char *groupname;
+} gid_cache_entry_t;
+
 static pthread_mutex_t uid_lock = PTHREAD_MUTEX_INITIALIZER;
 static uid_cache_entry_t *uid_cache = NULL;
 static int uid_cache_used = 0;
 
+static pthread_mutex_t gid_lock = PTHREAD_MUTEX_INITIALIZER;
+static gid_cache_entry_t *gid_cache = NULL;
+static int gid_cache_used = 0;
+
 static int _getpwnam_r (const char *name, struct passwd *pwd, char *buf,
 		size_t bufsiz, struct passwd **result)
 {
@@ -359,6 +368,62 @@ int gid_from_string(const char *name, gid_t *gidp)
 	return 0;
 }
 
+static int _gid_compare(const void *a, const void *b)
+{
+	gid_t ga = *(const gid_t *)a;
+	gid_t gb = *(const gid_t *)b;
+
+	if (ga < gb)
+		return -1;
+	else if (ga > gb)
+		return 1;
+
+	return 0;
+}
+
+extern void gid_cache_clear(void)
+{
+	int i;
+
+	slurm_mutex_lock(&gid_lock);
+	for (i = 0; i < gid_cache_used; i++)
+		xfree(gid_cache[i].groupname);
+	xfree(gid_cache);
+	gid_cache_used = 0;
+	slurm_mutex_unlock(&gid_lock);
+}
+
+extern char *gid_to_string_cached(gid_t gid)
+{
+	gid_cache_entry_t *entry;
+	gid_cache_entry_t target = {gid, NULL};
+	int inx;
+
+	slurm_mutex_lock(&gid_lock);
+	entry = bsearch(&target, gid_cache, gid_cache_used,
+			sizeof(gid_cache_entry_t), _gid_compare);
+	if (entry == NULL) {
+		gid_cache_entry_t new_entry = {gid, gid_to_string(gid)};
+
+		/* Insert in place to keep the cache sorted */
+		for (inx = 0; inx < gid_cache_used; inx++) {
+			if (gid_cache[inx].gid > gid)
+				break;
+		}
+		gid_cache_used++;
+		gid_cache = xrealloc(gid_cache,
+				     sizeof(gid_cache_entry_t)*gid_cache_used);
+		memmove(&gid_cache[inx + 1], &gid_cache[inx],
+			sizeof(gid_cache_entry_t) *
+			(gid_cache_used - inx - 1));
+		gid_cache[inx] = new_entry;
+		slurm_mutex_unlock(&gid_lock);
+		return new_entry.groupname;
+	}
+	slurm_mutex_unlock(&gid_lock);
+	return entry->groupname;
+}
+
 extern char *gid_to_string(gid_t gid)
 {
 	char *result = gid_to_string_or_null(gid);
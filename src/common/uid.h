@@ -127,4 +127,13 @@ extern char *gid_to_string(gid_t gid);
  */
 char *gid_to_string_or_null(gid_t gid);
 
+/* Free any memory allocated by gid_to_string_cached() */
+extern void gid_cache_clear(void);
+
+/*
+ * Translate gid to group name, using a cache.
+ * Call gid_cache_clear() to free memory.
+ */
+extern char *gid_to_string_cached(gid_t gid);
+
 #endif /*__SLURM_UID_UTILITY_H__*/
@@ -71,6 +71,7 @@ typedef struct {
 	slurm_cred_t *(*cred_create)	(slurm_cred_arg_t *cred_arg,
 					 bool sign_it,
 					 uint16_t protocol_version);
+	int (*cred_sign)		(slurm_cred_t *cred);
 	slurm_cred_t *(*cred_unpack)	(buf_t *buffer,
 					 uint16_t protocol_version);
 	char *(*create_net_cred)	(void *addrs,
@@ -89,6 +90,7 @@ typedef struct {
  */
 static const char *syms[] = {
 	"cred_p_create",
+	"cred_p_sign",
 	"cred_p_unpack",
 	"cred_p_create_net_cred",
 	"cred_p_extract_net_cred",
@@ -230,6 +232,21 @@ extern slurm_cred_t *slurm_cred_create(slurm_cred_arg_t *arg, bool sign_it,
 	return cred;
 }
 
+extern int slurm_cred_sign(slurm_cred_t *cred)
+{
+	int rc;
+
+	xassert(cred);
+	xassert(cred->magic == CRED_MAGIC);
+	xassert(g_context);
+
+	slurm_rwlock_wrlock(&cred->mutex);
+	rc = (*(ops.cred_sign))(cred);
+	slurm_rwlock_unlock(&cred->mutex);
+
+	return rc;
+}
+
 extern slurm_cred_t *slurm_cred_faker(slurm_cred_arg_t *arg)
 {
 	/*
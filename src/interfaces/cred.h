@@ -198,6 +198,16 @@ extern int cred_g_fini(void);
 extern slurm_cred_t *slurm_cred_create(slurm_cred_arg_t *arg, bool sign_it,
 				       uint16_t protocol_version);
 
+/*
+ * Sign a credential returned by slurm_cred_create(), replacing any signature
+ * it already has. This lets the caller create the credential while holding
+ * the locks protecting `arg' and sign it after they are released.
+ *
+ * Returns SLURM_SUCCESS or SLURM_ERROR. On failure the credential is left
+ * unsigned.
+ */
+extern int slurm_cred_sign(slurm_cred_t *cred);
+
 /*
  * Allocate a credential.
  */
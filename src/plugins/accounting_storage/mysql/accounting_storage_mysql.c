@@ -3038,7 +3038,7 @@ extern int _add_feds_to_update_list(mysql_conn_t *mysql_conn, List update_list)
 
 extern int acct_storage_p_commit(mysql_conn_t *mysql_conn, bool commit)
 {
-	int rc = check_connection(mysql_conn);
+	int rc = check_connection(mysql_conn), commit_rc = SLURM_SUCCESS;
 	List update_list = NULL;
 
 	/* always reset this here */
@@ -3063,7 +3063,6 @@ extern int acct_storage_p_commit(mysql_conn_t *mysql_conn, bool commit)
 			if (mysql_db_rollback(mysql_conn))
 				error("rollback failed");
 		} else {
-			int rc = SLURM_SUCCESS;
 			/*
 			 * Handle anything here we were unable to do
 			 * because of rollback issues.
@@ -3072,16 +3071,16 @@ extern int acct_storage_p_commit(mysql_conn_t *mysql_conn, bool commit)
 				DB_DEBUG(DB_ASSOC, mysql_conn->conn,
 				         "query\n%s",
 				         mysql_conn->pre_commit_query);
-				rc = mysql_db_query(
+				commit_rc = mysql_db_query(
 					mysql_conn,
 					mysql_conn->pre_commit_query);
 			}
 
-			if (rc != SLURM_SUCCESS) {
+			if (commit_rc != SLURM_SUCCESS) {
 				if (mysql_db_rollback(mysql_conn))
 					error("rollback failed");
 			} else {
-				if (mysql_db_commit(mysql_conn))
+				if ((commit_rc = mysql_db_commit(mysql_conn)))
 					error("commit failed");
 				else if (mysql_conn->flags &
 					 DB_CONN_FLAG_FEDUPDATE)
@@ -3092,7 +3091,7 @@ extern int acct_storage_p_commit(mysql_conn_t *mysql_conn, bool commit)
 		}
 	}
 
-	if (commit && list_count(update_list)) {
+	if (commit && (commit_rc == SLURM_SUCCESS) && list_count(update_list)) {
 		list_itr_t *itr = NULL;
 		slurmdb_update_object_t *object = NULL;
 
@@ -3138,7 +3137,7 @@ extern int acct_storage_p_commit(mysql_conn_t *mysql_conn, bool commit)
 	xfree(mysql_conn->pre_commit_query);
 	FREE_NULL_LIST(update_list);
 
-	return SLURM_SUCCESS;
+	return commit_rc;
 }
 
 extern int acct_storage_p_add_users(mysql_conn_t *mysql_conn, uint32_t uid,
@@ -78,6 +78,33 @@ typedef struct {
 	char *ret_str_pos;
 } mod_def_qos_t;
 
+/* Inherited limits of a parent account as returned by get_parent_limits() */
+typedef struct {
+	char *acct;
+	uint32_t def_qos_id;
+	char *delta_qos;
+	uint32_t mj;
+	uint32_t mja;
+	uint32_t mpt;
+	uint32_t msj;
+	char *mtmpj;
+	char *mtpj;
+	char *mtpn;
+	char *mtrm;
+	uint32_t mwpj;
+	uint32_t prio;
+	char *qos;
+} parent_limits_t;
+
+static parent_limits_t no_parent_limits = {
+	.mj = INFINITE,
+	.mja = INFINITE,
+	.mpt = INFINITE,
+	.msj = INFINITE,
+	.mwpj = INFINITE,
+	.prio = INFINITE,
+};
+
 /* if this changes you will need to edit the corresponding enum */
 char *assoc_req_inx[] = {
 	"id_assoc",
@@ -2137,6 +2164,108 @@ end_it:
 	return rc;
 }
 
+static void _destroy_parent_limits(void *object)
+{
+	parent_limits_t *parent = object;
+
+	if (!parent)
+		return;
+
+	xfree(parent->acct);
+	xfree(parent->delta_qos);
+	xfree(parent->mtmpj);
+	xfree(parent->mtpj);
+	xfree(parent->mtpn);
+	xfree(parent->mtrm);
+	xfree(parent->qos);
+	xfree(parent);
+}
+
+static int _find_parent_limits(void *x, void *key)
+{
+	parent_limits_t *parent = x;
+
+	return !xstrcmp(parent->acct, key);
+}
+
+static uint32_t _parent_limit_atoul(MYSQL_ROW row, int inx)
+{
+	return row[inx] ? slurm_atoul(row[inx]) : INFINITE;
+}
+
+static char *_parent_limit_strdup(MYSQL_ROW row, int inx)
+{
+	return row[inx][0] ? xstrdup(row[inx]) : NULL;
+}
+
+/*
+ * Get the limits of parent_acct through get_parent_limits(). Results are
+ * cached in parent_list since the same parent is needed again for every
+ * sibling association listed after its children.
+ *
+ * RET the cached limits, NULL if the parent has no limits row (the caller
+ * keeps its previous limits), or NULL with *rc set to SLURM_ERROR on failure.
+ */
+static parent_limits_t *_get_parent_limits(mysql_conn_t *mysql_conn,
+					   list_t *parent_list,
+					   char *parent_acct,
+					   char *cluster_name,
+					   uint16_t without_parent_limits,
+					   int *rc)
+{
+	parent_limits_t *parent;
+	MYSQL_RES *result;
+	MYSQL_ROW row;
+	char *query;
+
+	if ((parent = list_find_first(parent_list, _find_parent_limits,
+				      parent_acct)))
+		return parent;
+
+	query = xstrdup_printf("call get_parent_limits('%s', '%s', '%s', %u);",
+			       assoc_table, parent_acct, cluster_name,
+			       without_parent_limits);
+	debug4("%d(%s:%d) query\n%s",
+	       mysql_conn->conn, THIS_FILE, __LINE__, query);
+	result = mysql_db_query_ret(mysql_conn, query, 1);
+	xfree(query);
+	if (!result) {
+		*rc = SLURM_ERROR;
+		return NULL;
+	}
+
+	if (!(row = mysql_fetch_row(result))) {
+		mysql_free_result(result);
+		return NULL;
+	}
+
+	parent = xmalloc(sizeof(*parent));
+	*parent = no_parent_limits;
+	parent->acct = xstrdup(parent_acct);
+
+	if (!without_parent_limits) {
+		parent->def_qos_id = row[ASSOC2_REQ_DEF_QOS] ?
+			slurm_atoul(row[ASSOC2_REQ_DEF_QOS]) : 0;
+		parent->mj = _parent_limit_atoul(row, ASSOC2_REQ_MJ);
+		parent->mja = _parent_limit_atoul(row, ASSOC2_REQ_MJA);
+		parent->mpt = _parent_limit_atoul(row, ASSOC2_REQ_MPT);
+		parent->msj = _parent_limit_atoul(row, ASSOC2_REQ_MSJ);
+		parent->mwpj = _parent_limit_atoul(row, ASSOC2_REQ_MWPJ);
+		parent->prio = _parent_limit_atoul(row, ASSOC2_REQ_PRIO);
+		parent->mtpj = _parent_limit_strdup(row, ASSOC2_REQ_MTPJ);
+		parent->mtpn = _parent_limit_strdup(row, ASSOC2_REQ_MTPN);
+		parent->mtmpj = _parent_limit_strdup(row, ASSOC2_REQ_MTMPJ);
+		parent->mtrm = _parent_limit_strdup(row, ASSOC2_REQ_MTRM);
+		parent->qos = _parent_limit_strdup(row, ASSOC2_REQ_QOS);
+		parent->delta_qos = _parent_limit_strdup(row,
+							 ASSOC2_REQ_DELTA_QOS);
+	}
+	mysql_free_result(result);
+
+	list_append(parent_list, parent);
+	return parent;
+}
+
 static int _cluster_get_assocs(mysql_conn_t *mysql_conn,
 			       slurmdb_user_rec_t *user,
 			       slurmdb_assoc_cond_t *assoc_cond,
@@ -2146,26 +2275,14 @@ static int _cluster_get_assocs(mysql_conn_t *mysql_conn,
 {
 	List assoc_list;
 	List delta_qos_list = NULL;
+	list_t *parent_list = NULL;
 	list_itr_t *itr = NULL;
 	MYSQL_RES *result = NULL;
 	MYSQL_ROW row;
-	uint32_t parent_def_qos_id = 0;
-	uint32_t parent_mj = INFINITE;
-	uint32_t parent_mja = INFINITE;
-	uint32_t parent_mpt = INFINITE;
-	uint32_t parent_msj = INFINITE;
-	uint32_t parent_mwpj = INFINITE;
-	uint32_t parent_prio = INFINITE;
-	char *parent_mtpj = NULL;
-	char *parent_mtpn = NULL;
-	char *parent_mtmpj = NULL;
-	char *parent_mtrm = NULL;
-	char *parent_acct = NULL;
-	char *parent_qos = NULL;
-	char *parent_delta_qos = NULL;
-	char *last_acct = NULL;
-	char *last_cluster = NULL;
+	parent_limits_t *parent = &no_parent_limits;
+	char *parent_acct = NULL, *last_parent_acct = NULL;
 	char *query = NULL;
+	int rc = SLURM_SUCCESS;
 	char *extra = xstrdup(sent_extra);
 
 	/* needed if we don't have an assoc_cond */
@@ -2259,11 +2376,10 @@ static int _cluster_get_assocs(mysql_conn_t *mysql_conn,
 
 	assoc_list = list_create(slurmdb_destroy_assoc_rec);
 	delta_qos_list = list_create(xfree_ptr);
+	parent_list = list_create(_destroy_parent_limits);
 	while ((row = mysql_fetch_row(result))) {
 		slurmdb_assoc_rec_t *assoc =
 			xmalloc(sizeof(slurmdb_assoc_rec_t));
-		MYSQL_RES *result2 = NULL;
-		MYSQL_ROW row2;
 		uint16_t deleted = slurm_atoul(row[ASSOC_REQ_DELETED]);
 		list_append(assoc_list, assoc);
 		assoc->id = slurm_atoul(row[ASSOC_REQ_ID]);
@@ -2333,146 +2449,62 @@ static int _cluster_get_assocs(mysql_conn_t *mysql_conn,
 		else
 			assoc->shares_raw = 1;
 
+		/*
+		 * Rows of the same parent are mostly consecutive, so only look
+		 * the parent up again when it changes.
+		 */
 		if (!without_parent_info && parent_acct &&
-		    (!last_acct || !last_cluster
-		     || xstrcmp(parent_acct, last_acct)
-		     || xstrcmp(cluster_name, last_cluster))) {
-			query = xstrdup_printf(
-				"call get_parent_limits('%s', "
-				"'%s', '%s', %u);",
-				assoc_table, parent_acct,
-				cluster_name,
-				without_parent_limits);
-			debug4("%d(%s:%d) query\n%s",
-			       mysql_conn->conn, THIS_FILE, __LINE__, query);
-			if (!(result2 = mysql_db_query_ret(
-				      mysql_conn, query, 1))) {
-				xfree(query);
+		    xstrcmp(parent_acct, last_parent_acct)) {
+			parent_limits_t *found;
+
+			xfree(last_parent_acct);
+			last_parent_acct = xstrdup(parent_acct);
+			found = _get_parent_limits(
+				mysql_conn, parent_list, parent_acct,
+				cluster_name, without_parent_limits, &rc);
+			if (rc != SLURM_SUCCESS)
 				break;
-			}
-			xfree(query);
-
-			if (!(row2 = mysql_fetch_row(result2))) {
-				goto no_parent_limits;
-			}
-
-			if (!without_parent_limits) {
-				if (row2[ASSOC2_REQ_DEF_QOS])
-					parent_def_qos_id = slurm_atoul(
-						row2[ASSOC2_REQ_DEF_QOS]);
-				else
-					parent_def_qos_id = 0;
-
-				if (row2[ASSOC2_REQ_MJ])
-					parent_mj = slurm_atoul(
-						row2[ASSOC2_REQ_MJ]);
-				else
-					parent_mj = INFINITE;
-
-				if (row2[ASSOC2_REQ_MJA])
-					parent_mja = slurm_atoul(
-						row2[ASSOC2_REQ_MJA]);
-				else
-					parent_mja = INFINITE;
-
-				if (row2[ASSOC2_REQ_MPT])
-					parent_mpt = slurm_atoul(
-						row2[ASSOC2_REQ_MPT]);
-				else
-					parent_mpt = INFINITE;
-
-				if (row2[ASSOC2_REQ_MSJ])
-					parent_msj = slurm_atoul(
-						row2[ASSOC2_REQ_MSJ]);
-				else
-					parent_msj = INFINITE;
-
-				if (row2[ASSOC2_REQ_MWPJ])
-					parent_mwpj = slurm_atoul(
-						row2[ASSOC2_REQ_MWPJ]);
-				else
-					parent_mwpj = INFINITE;
-
-
-				if (row2[ASSOC2_REQ_PRIO])
-					parent_prio = slurm_atoul(
-						row2[ASSOC2_REQ_PRIO]);
-				else
-					parent_prio = INFINITE;
-
-				xfree(parent_mtpj);
-				if (row2[ASSOC2_REQ_MTPJ][0])
-					parent_mtpj = xstrdup(
-						row2[ASSOC2_REQ_MTPJ]);
-
-				xfree(parent_mtpn);
-				if (row2[ASSOC2_REQ_MTPN][0])
-					parent_mtpn = xstrdup(
-						row2[ASSOC2_REQ_MTPN]);
-
-				xfree(parent_mtmpj);
-				if (row2[ASSOC2_REQ_MTMPJ][0])
-					parent_mtmpj = xstrdup(
-						row2[ASSOC2_REQ_MTMPJ]);
-
-				xfree(parent_mtrm);
-				if (row2[ASSOC2_REQ_MTRM][0])
-					parent_mtrm = xstrdup(
-						row2[ASSOC2_REQ_MTRM]);
-
-				xfree(parent_qos);
-				if (row2[ASSOC2_REQ_QOS][0])
-					parent_qos =
-						xstrdup(row2[ASSOC2_REQ_QOS]);
-
-				xfree(parent_delta_qos);
-				if (row2[ASSOC2_REQ_DELTA_QOS][0])
-					parent_delta_qos = xstrdup(
-						row2[ASSOC2_REQ_DELTA_QOS]);
-			}
-			last_acct = parent_acct;
-			last_cluster = cluster_name;
-		no_parent_limits:
-			mysql_free_result(result2);
+			if (found)
+				parent = found;
 		}
 
 		if (row[ASSOC_REQ_DEF_QOS])
 			assoc->def_qos_id = slurm_atoul(row[ASSOC_REQ_DEF_QOS]);
 		else
-			assoc->def_qos_id = parent_def_qos_id;
+			assoc->def_qos_id = parent->def_qos_id;
 
 		if (row[ASSOC_REQ_MJ])
 			assoc->max_jobs = slurm_atoul(row[ASSOC_REQ_MJ]);
 		else
-			assoc->max_jobs = parent_mj;
+			assoc->max_jobs = parent->mj;
 
 		if (row[ASSOC_REQ_MJA])
 			assoc->max_jobs_accrue =
 				slurm_atoul(row[ASSOC_REQ_MJA]);
 		else
-			assoc->max_jobs_accrue = parent_mja;
+			assoc->max_jobs_accrue = parent->mja;
 
 		if (row[ASSOC_REQ_MPT])
 			assoc->min_prio_thresh = slurm_atoul(
 				row[ASSOC_REQ_MPT]);
 		else
-			assoc->min_prio_thresh = parent_mpt;
+			assoc->min_prio_thresh = parent->mpt;
 
 		if (row[ASSOC_REQ_MSJ])
 			assoc->max_submit_jobs = slurm_atoul(
 				row[ASSOC_REQ_MSJ]);
 		else
-			assoc->max_submit_jobs = parent_msj;
+			assoc->max_submit_jobs = parent->msj;
 
 		if (row[ASSOC_REQ_MWPJ])
 			assoc->max_wall_pj = slurm_atoul(row[ASSOC_REQ_MWPJ]);
 		else
-			assoc->max_wall_pj = parent_mwpj;
+			assoc->max_wall_pj = parent->mwpj;
 
 		if (row[ASSOC_REQ_PRIO])
 			assoc->priority = slurm_atoul(row[ASSOC_REQ_PRIO]);
 		else
-			assoc->priority = parent_prio;
+			assoc->priority = parent->prio;
 
 		if (row[ASSOC_REQ_MTPJ][0])
 			assoc->max_tres_pj = xstrdup(row[ASSOC_REQ_MTPJ]);
@@ -2492,16 +2524,16 @@ static int _cluster_get_assocs(mysql_conn_t *mysql_conn,
 		 * TRES.
 		 */
 		slurmdb_combine_tres_strings(
-			&assoc->max_tres_pj, parent_mtpj,
+			&assoc->max_tres_pj, parent->mtpj,
 			TRES_STR_FLAG_SORT_ID);
 		slurmdb_combine_tres_strings(
-			&assoc->max_tres_pn, parent_mtpn,
+			&assoc->max_tres_pn, parent->mtpn,
 			TRES_STR_FLAG_SORT_ID);
 		slurmdb_combine_tres_strings(
-			&assoc->max_tres_mins_pj, parent_mtmpj,
+			&assoc->max_tres_mins_pj, parent->mtmpj,
 			TRES_STR_FLAG_SORT_ID);
 		slurmdb_combine_tres_strings(
-			&assoc->max_tres_run_mins, parent_mtrm,
+			&assoc->max_tres_run_mins, parent->mtrm,
 			TRES_STR_FLAG_SORT_ID);
 
 		assoc->qos_list = list_create(xfree_ptr);
@@ -2521,14 +2553,14 @@ static int _cluster_get_assocs(mysql_conn_t *mysql_conn,
 			*/
 
 			/* add the parents first */
-			if (parent_qos)
+			if (parent->qos)
 				slurm_addto_char_list(assoc->qos_list,
-						      parent_qos+1);
+						      parent->qos+1);
 
 			/* then add the parents delta */
-			if (parent_delta_qos)
+			if (parent->delta_qos)
 				slurm_addto_char_list(delta_qos_list,
-						      parent_delta_qos+1);
+						      parent->delta_qos+1);
 
 			/* now add the associations */
 			if (row[ASSOC_REQ_DELTA_QOS][0])
@@ -2587,16 +2619,11 @@ static int _cluster_get_assocs(mysql_conn_t *mysql_conn,
 		//info("parent id is %d", assoc->parent_id);
 		//log_assoc_rec(assoc);
 	}
-	xfree(parent_mtpj);
-	xfree(parent_mtpn);
-	xfree(parent_mtmpj);
-	xfree(parent_mtrm);
 	mysql_free_result(result);
 
 	FREE_NULL_LIST(delta_qos_list);
-
-	xfree(parent_delta_qos);
-	xfree(parent_qos);
+	FREE_NULL_LIST(parent_list);
+	xfree(last_parent_acct);
 
 	if (with_usage && assoc_list && list_count(assoc_list))
 		get_usage_for_list(mysql_conn, DBD_GET_ASSOC_USAGE,
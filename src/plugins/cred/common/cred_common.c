@@ -220,6 +220,9 @@ extern slurm_cred_t *cred_create(slurm_cred_arg_t *cred,
 		packstr(cred->job_selinux_context, buffer);
 	}
 
+	/* signature follows the main buffer */
+	credential->sig_offset = get_buf_offset(buffer);
+
 	return credential;
 }
 
@@ -299,19 +299,36 @@ static int _verify_signature(char *buffer, uint32_t buf_size, char *signature)
 	return rc;
 }
 
+extern int cred_p_sign(slurm_cred_t *cred)
+{
+	/* Replace any signature packed when the credential was created */
+	set_buf_offset(cred->buffer, cred->sig_offset);
+	xfree(cred->signature);
+
+	if (!(cred->signature = _encode(cred->buffer))) {
+		error("%s: failed to sign", __func__);
+		packnull(cred->buffer);
+		return SLURM_ERROR;
+	}
+
+	packstr(cred->signature, cred->buffer);
+
+	return SLURM_SUCCESS;
+}
+
 extern slurm_cred_t *cred_p_create(slurm_cred_arg_t *cred_arg, bool sign_it,
 				   uint16_t protocol_version)
 {
 	slurm_cred_t *cred = cred_create(cred_arg, protocol_version);
 
-	if (sign_it && !(cred->signature = _encode(cred->buffer))) {
+	if (!sign_it) {
+		packnull(cred->buffer);
+	} else if (cred_p_sign(cred)) {
 		error("%s: failed to sign, returning NULL", __func__);
 		slurm_cred_destroy(cred);
 		return NULL;
 	}
 
-	packstr(cred->signature, cred->buffer);
-
 	return cred;
 }
 
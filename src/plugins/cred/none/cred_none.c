@@ -108,6 +108,15 @@ extern slurm_cred_t *cred_p_create(slurm_cred_arg_t *cred_arg, bool sign_it,
 	return cred;
 }
 
+extern int cred_p_sign(slurm_cred_t *cred)
+{
+	set_buf_offset(cred->buffer, cred->sig_offset);
+	xfree(cred->signature);
+	cred->signature = xstrdup("fake signature");
+	packstr(cred->signature, cred->buffer);
+	return SLURM_SUCCESS;
+}
+
 extern slurm_cred_t *cred_p_unpack(buf_t *buf, uint16_t protocol_version)
 {
 	slurm_cred_t *credential = NULL;
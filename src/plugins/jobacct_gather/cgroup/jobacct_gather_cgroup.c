@@ -83,6 +83,7 @@ const char plugin_type[] = "jobacct_gather/cgroup";
 const uint32_t plugin_version = SLURM_VERSION_NUMBER;
 
 static bool is_first_task = true;
+static bool cgroup_mem_missing = false;
 
 static void _prec_extra(jag_prec_t *prec, uint32_t taskid)
 {
@@ -92,6 +93,7 @@ static void _prec_extra(jag_prec_t *prec, uint32_t taskid)
 
 	if (!cgroup_acct_data) {
 		error("Cannot get cgroup accounting data for %d", taskid);
+		cgroup_mem_missing = true;
 		return;
 	}
 
@@ -110,6 +112,7 @@ static void _prec_extra(jag_prec_t *prec, uint32_t taskid)
 	    cgroup_acct_data->total_vmem == NO_VAL64) {
 		debug2("failed to collect cgroup memory stats pid %d ppid %d",
 		       prec->pid, prec->ppid);
+		cgroup_mem_missing = true;
 	} else {
 		/*
 		 * This number represents the amount of "dirty" private memory
@@ -225,6 +228,14 @@ extern void jobacct_gather_p_poll_data(List task_list, uint64_t cont_id,
 		callbacks.prec_extra = _prec_extra;
 	}
 
+	/*
+	 * The cgroup memory usage of a task replaces what is read from /proc,
+	 * so avoid reading statm or smaps of every process. Once the cgroup
+	 * fails to provide it, the /proc values are kept and have to honor
+	 * NoShare and UsePss again from the next poll on.
+	 */
+	callbacks.prec_extra_mem = !cgroup_mem_missing;
+
 	jag_common_poll_data(task_list, cont_id, &callbacks, profile);
 
 	return;
@@ -153,13 +153,12 @@ static int _get_pss(char *proc_smaps_file, jag_prec_t *prec)
         FILE *fp;
 	int i;
 
-	fp = fopen(proc_smaps_file, "r");
+	/* "e" sets O_CLOEXEC on open, no need for a separate fcntl() */
+	fp = fopen(proc_smaps_file, "re");
         if (!fp) {
                 return -1;
         }
 
-	if (fcntl(fileno(fp), F_SETFD, FD_CLOEXEC) == -1)
-		error("%s: fcntl(%s): %m", __func__, proc_smaps_file);
 	pss = 0;
 
         while (fgets(line,sizeof(line),fp)) {
@@ -218,18 +217,15 @@ static int _get_sys_interface_freq_line(uint32_t cpu, char *filename,
 		 "/sys/devices/system/cpu/cpu%d/cpufreq/%s",
 		 cpu, filename);
 	log_flag(JAG, "filename = %s", freq_file);
-	if ((sys_fp = fopen(freq_file, "r"))!= NULL) {
+	if ((fd = open(freq_file, O_RDONLY | O_CLOEXEC)) >= 0) {
 		/* frequency scaling enabled */
-		fd = fileno(sys_fp);
-		if (fcntl(fd, F_SETFD, FD_CLOEXEC) == -1)
-			error("%s: fcntl(%s): %m", __func__, freq_file);
 		num_read = read(fd, sbuf, (sizeof(sbuf) - 1));
 		if (num_read > 0) {
 			sbuf[num_read] = '\0';
 			log_flag(JAG, "scaling enabled on cpu %d freq= %s",
 				 cpu, sbuf);
 		}
-		fclose(sys_fp);
+		close(fd);
 	} else {
 		/* frequency scaling not enabled */
 		if (!cpunfo_frequency) {
@@ -432,16 +428,12 @@ static int _get_process_memory_line(int in, jag_prec_t *prec)
 
 static int _remove_share_data(char *proc_statm_file, jag_prec_t *prec)
 {
-	FILE *statm_fp = NULL;
 	int rc = 0, fd;
 
-	if (!(statm_fp = fopen(proc_statm_file, "r")))
+	if ((fd = open(proc_statm_file, O_RDONLY | O_CLOEXEC)) < 0)
 		return rc;  /* Assume the process went away */
-	fd = fileno(statm_fp);
-	if (fcntl(fd, F_SETFD, FD_CLOEXEC) == -1)
-		error("%s: fcntl(%s): %m", __func__, proc_statm_file);
 	rc = _get_process_memory_line(fd, prec);
-	fclose(statm_fp);
+	close(fd);
 	return rc;
 }
 
@@ -474,8 +466,7 @@ static int _get_process_io_data_line(int in, jag_prec_t *prec) {
 	if (nvals < 4)
 		return 0;
 
-	if (_is_a_lwp(prec->pid))
-		return 0;
+	/* LWPs were already skipped by _get_process_data_line() */
 
 	/* keep real value here since we aren't doubles */
 	prec->tres_data[TRES_ARRAY_FS_DISK].size_read = rchar;
@@ -525,9 +516,7 @@ static void _handle_stats(pid_t pid, jag_callbacks_t *callbacks, int tres_count)
 	static int use_pss = -1;
 	static int disable_gpu_acct = -1;
 	char *proc_file = NULL;
-	FILE *stat_fp = NULL;
-	FILE *io_fp = NULL;
-	int fd, fd2;
+	int fd;
 	jag_prec_t *prec = NULL;
 
 	if (no_share_data == -1) {
@@ -551,22 +540,15 @@ static void _handle_stats(pid_t pid, jag_callbacks_t *callbacks, int tres_count)
 			disable_gpu_acct = 0;
 	}
 
-	xstrfmtcat(proc_file, "/proc/%u/stat", pid);
-	if (!(stat_fp = fopen(proc_file, "r")))
-		return;  /* Assume the process went away */
 	/*
-	 * Close the file on exec() of user tasks.
-	 *
-	 * NOTE: If we fork() slurmstepd after the
-	 * fopen() above and before the fcntl() below,
-	 * then the user task may have this extra file
-	 * open, which can cause problems for
-	 * checkpoint/restart, but this should be a very rare
-	 * problem in practice.
+	 * Open with O_CLOEXEC so a user task forked meanwhile never inherits
+	 * the file, and skip stdio as every file is read with a single read().
 	 */
-	fd = fileno(stat_fp);
-	if (fcntl(fd, F_SETFD, FD_CLOEXEC) == -1)
-		error("%s: fcntl(%s): %m", __func__, proc_file);
+	xstrfmtcat(proc_file, "/proc/%u/stat", pid);
+	if ((fd = open(proc_file, O_RDONLY | O_CLOEXEC)) < 0) {
+		xfree(proc_file);
+		return;  /* Assume the process went away */
+	}
 
 	prec = xmalloc(sizeof(*prec));
 
@@ -586,15 +568,22 @@ static void _handle_stats(pid_t pid, jag_callbacks_t *callbacks, int tres_count)
 	(void)_init_tres(prec, NULL);
 
 	if (!_get_process_data_line(fd, prec)) {
-		fclose(stat_fp);
+		close(fd);
 		goto bail_out;
 	}
 
-	fclose(stat_fp);
+	close(fd);
 
 	if (!disable_gpu_acct)
 		gpu_g_usage_read(pid, prec->tres_data);
 
+	/*
+	 * Skip the extra per process reads for memory usage when it will be
+	 * replaced by the usage of the task as a whole (e.g. from its cgroup).
+	 */
+	if (callbacks->prec_extra_mem)
+		goto io;
+
 	/* Remove shared data from rss */
 	if (no_share_data) {
 		xfree(proc_file);
@@ -611,17 +600,15 @@ static void _handle_stats(pid_t pid, jag_callbacks_t *callbacks, int tres_count)
 			goto bail_out;
 	}
 
+io:
 	xfree(proc_file);
 	xstrfmtcat(proc_file, "/proc/%u/io", pid);
-	if ((io_fp = fopen(proc_file, "r"))) {
-		fd2 = fileno(io_fp);
-		if (fcntl(fd2, F_SETFD, FD_CLOEXEC) == -1)
-			error("%s: fcntl: %m", __func__);
-		if (!_get_process_io_data_line(fd2, prec)) {
-			fclose(io_fp);
+	if ((fd = open(proc_file, O_RDONLY | O_CLOEXEC)) >= 0) {
+		if (!_get_process_io_data_line(fd, prec)) {
+			close(fd);
 			goto bail_out;
 		}
-		fclose(io_fp);
+		close(fd);
 	}
 
 	destroy_jag_prec(list_remove_first(prec_list, _find_prec, &prec->pid));
@@ -630,6 +617,7 @@ static void _handle_stats(pid_t pid, jag_callbacks_t *callbacks, int tres_count)
 	return;
 
 bail_out:
+	xfree(proc_file);
 	xfree(prec->tres_data);
 	xfree(prec);
 	return;
@@ -62,6 +62,7 @@ typedef struct jag_callbacks {
 			   struct jag_callbacks *callbacks);
 	void (*get_offspring_data) (List prec_list,
 				    jag_prec_t *ancestor, pid_t pid);
+	bool prec_extra_mem; /* prec_extra() sets memory usage of the task */
 } jag_callbacks_t;
 
 extern void jag_common_init(long in_hertz);
@@ -139,6 +139,16 @@ static void _handle_gres_exc_basic(resv_exc_t *resv_exc_ptr,
 	return;
 }
 
+/* Test if any core of socket sock is set in a node's core bitmap */
+static bool _sock_core_test(bitstr_t *core_bitmap, int sock,
+			    uint16_t cores_per_sock)
+{
+	int first_core = sock * cores_per_sock;
+
+	return (bit_set_count_range(core_bitmap, first_core,
+				    first_core + cores_per_sock) > 0);
+}
+
 /*
  * Determine how many GRES of a given type can be used by this job on a
  * given node and return a structure with the details. Note that multiple
@@ -159,17 +169,25 @@ static sock_gres_t *_build_sock_gres_by_topo(
 	gres_job_state_t *gres_js = gres_state_job->gres_data;
 	gres_node_state_t *gres_ns = gres_state_node->gres_data;
 	gres_node_state_t *alt_gres_ns = NULL;
-	int i, j, s, c;
+	int i, s, c;
 	uint32_t tot_cores;
 	sock_gres_t *sock_gres;
 	int64_t add_gres;
 	uint64_t avail_gres, min_gres = 0;
 	bool match = false;
 	bool use_busy_dev = gres_use_busy_dev(gres_state_node, use_total_gres);
+	bool *avail_sock_flag = NULL, *topo_sock_flag = NULL;
 
 	if (gres_ns->gres_cnt_avail == 0)
 		return NULL;
 
+	tot_cores = sockets * cores_per_sock;
+	if (core_bitmap && (tot_cores != bit_size(core_bitmap))) {
+		error("%s: Core bitmaps size mismatch on node %s",
+		      __func__, node_name);
+		return NULL;
+	}
+
 	if (!use_total_gres)
 		alt_gres_ns = gres_ns->alt_gres ?
 			gres_ns->alt_gres->gres_data : NULL;
@@ -179,6 +197,18 @@ static sock_gres_t *_build_sock_gres_by_topo(
 	sock_gres->bits_by_sock = xcalloc(sockets, sizeof(bitstr_t *));
 	sock_gres->cnt_by_sock = xcalloc(sockets, sizeof(uint64_t));
 
+	/*
+	 * Sockets with some core left in core_bitmap, tested once here rather
+	 * than core by core for every topo record and every pass below.
+	 */
+	if (core_bitmap) {
+		avail_sock_flag = xcalloc(sockets, sizeof(bool));
+		for (s = 0; s < sockets; s++)
+			avail_sock_flag[s] = _sock_core_test(core_bitmap, s,
+							     cores_per_sock);
+	}
+	topo_sock_flag = xcalloc(sockets, sizeof(bool));
+
 	for (i = 0; i < gres_ns->topo_cnt; i++) {
 		bool use_all_sockets = false;
 		if (gres_js->type_name &&
@@ -242,10 +272,8 @@ static sock_gres_t *_build_sock_gres_by_topo(
 			 */
 			sock_gres->max_node_gres = avail_gres;
 
-		tot_cores = sockets * cores_per_sock;
-		if ((core_bitmap && (tot_cores != bit_size(core_bitmap))) ||
-		    (gres_ns->topo_core_bitmap[i] &&
-		     (tot_cores != bit_size(gres_ns->topo_core_bitmap[i])))) {
+		if (gres_ns->topo_core_bitmap[i] &&
+		    (tot_cores != bit_size(gres_ns->topo_core_bitmap[i]))) {
 			error("%s: Core bitmaps size mismatch on node %s",
 			      __func__, node_name);
 			match = false;
@@ -259,19 +287,11 @@ static sock_gres_t *_build_sock_gres_by_topo(
 		    gres_ns->topo_core_bitmap[i]) {
 			use_all_sockets = true;
 			for (s = 0; s < sockets; s++) {
-				bool use_this_socket = false;
-				for (c = 0; c < cores_per_sock; c++) {
-					j = (s * cores_per_sock) + c;
-					if (bit_test(gres_ns->
-						     topo_core_bitmap[i], j)) {
-						use_this_socket = true;
-						break;
-					}
-				}
-				if (!use_this_socket) {
+				topo_sock_flag[s] = _sock_core_test(
+					gres_ns->topo_core_bitmap[i], s,
+					cores_per_sock);
+				if (!topo_sock_flag[s])
 					use_all_sockets = false;
-					break;
-				}
 			}
 		}
 
@@ -298,44 +318,32 @@ static sock_gres_t *_build_sock_gres_by_topo(
 
 		/* Constrained by core */
 		for (s = 0; ((s < sockets) && avail_gres); s++) {
-			if (enforce_binding && core_bitmap) {
-				for (c = 0; c < cores_per_sock; c++) {
-					j = (s * cores_per_sock) + c;
-					if (bit_test(core_bitmap, j))
-						break;
-				}
-				if (c >= cores_per_sock) {
-					/* No available cores on this socket */
-					continue;
-				}
+			if (enforce_binding && core_bitmap &&
+			    !avail_sock_flag[s]) {
+				/* No available cores on this socket */
+				continue;
 			}
-			for (c = 0; c < cores_per_sock; c++) {
-				j = (s * cores_per_sock) + c;
-				if (gres_ns->topo_core_bitmap[i] &&
-				    !bit_test(gres_ns->topo_core_bitmap[i],
-					      j))
-					continue;
-				if (!gres_ns->topo_gres_bitmap[i]) {
-					error("%s: topo_gres_bitmap NULL on node %s",
-					      __func__, node_name);
-					continue;
-				}
-				if (!sock_gres->bits_by_sock[s]) {
-					sock_gres->bits_by_sock[s] =
-						bit_copy(gres_ns->
-							 topo_gres_bitmap[i]);
-				} else {
-					bit_or(sock_gres->bits_by_sock[s],
-					       gres_ns->topo_gres_bitmap[i]);
-				}
-				sock_gres->cnt_by_sock[s] += avail_gres;
-				sock_gres->total_cnt += avail_gres;
-				avail_gres = 0;
-				match = true;
-				break;
+			if (!topo_sock_flag[s])
+				continue;
+			if (!gres_ns->topo_gres_bitmap[i]) {
+				error("%s: topo_gres_bitmap NULL on node %s",
+				      __func__, node_name);
+				continue;
+			}
+			if (!sock_gres->bits_by_sock[s]) {
+				sock_gres->bits_by_sock[s] =
+					bit_copy(gres_ns->topo_gres_bitmap[i]);
+			} else {
+				bit_or(sock_gres->bits_by_sock[s],
+				       gres_ns->topo_gres_bitmap[i]);
 			}
+			sock_gres->cnt_by_sock[s] += avail_gres;
+			sock_gres->total_cnt += avail_gres;
+			avail_gres = 0;
+			match = true;
 		}
 	}
+	xfree(topo_sock_flag);
 
 	/* Process per-GRES limits */
 	if (match && gres_js->gres_per_socket) {
@@ -354,6 +362,7 @@ static sock_gres_t *_build_sock_gres_by_topo(
 					i = s * cores_per_sock;
 					bit_nclear(core_bitmap, i,
 						   i + cores_per_sock - 1);
+					avail_sock_flag[s] = false;
 				}
 			} else if (sock_gres->cnt_by_sock[s] >
 				   gres_js->gres_per_socket) {
@@ -375,23 +384,18 @@ static sock_gres_t *_build_sock_gres_by_topo(
 	 */
 	if (match && enforce_binding && core_bitmap && (s_p_n < sockets)) {
 		int avail_sock = 0;
-		bool *avail_sock_flag = xcalloc(sockets, sizeof(bool));
+		bool *spn_sock_flag = xcalloc(sockets, sizeof(bool));
 		for (s = 0; s < sockets; s++) {
-			if (sock_gres->cnt_by_sock[s] == 0)
+			if ((sock_gres->cnt_by_sock[s] == 0) ||
+			    !avail_sock_flag[s])
 				continue;
-			for (c = 0; c < cores_per_sock; c++) {
-				i = (s * cores_per_sock) + c;
-				if (!bit_test(core_bitmap, i))
-					continue;
-				avail_sock++;
-				avail_sock_flag[s] = true;
-				break;
-			}
+			avail_sock++;
+			spn_sock_flag[s] = true;
 		}
 		while (avail_sock > s_p_n) {
 			int low_gres_sock_inx = -1;
 			for (s = 0; s < sockets; s++) {
-				if (!avail_sock_flag[s])
+				if (!spn_sock_flag[s])
 					continue;
 				if ((low_gres_sock_inx == -1) ||
 				    (sock_gres->cnt_by_sock[s] <
@@ -406,9 +410,10 @@ static sock_gres_t *_build_sock_gres_by_topo(
 			sock_gres->total_cnt -= sock_gres->cnt_by_sock[s];
 			sock_gres->cnt_by_sock[s] = 0;
 			avail_sock--;
+			spn_sock_flag[s] = false;
 			avail_sock_flag[s] = false;
 		}
-		xfree(avail_sock_flag);
+		xfree(spn_sock_flag);
 	}
 
 	if (match) {
@@ -429,21 +434,14 @@ static sock_gres_t *_build_sock_gres_by_topo(
 	add_gres = min_gres - sock_gres->cnt_any_sock;
 	if (match && core_bitmap && (add_gres > 0)) {
 		int best_sock_inx = -1;
-		bool *avail_sock_flag = xcalloc(sockets, sizeof(bool));
 		for (s = 0; s < sockets; s++) {
-			if (sock_gres->cnt_by_sock[s] == 0)
+			if ((sock_gres->cnt_by_sock[s] == 0) ||
+			    !avail_sock_flag[s])
 				continue;
-			for (c = 0; c < cores_per_sock; c++) {
-				i = (s * cores_per_sock) + c;
-				if (!bit_test(core_bitmap, i))
-					continue;
-				avail_sock_flag[s] = true;
-				if ((best_sock_inx == -1) ||
-				    (sock_gres->cnt_by_sock[s] >
-				     sock_gres->cnt_by_sock[best_sock_inx])) {
-					best_sock_inx = s;
-				}
-				break;
+			if ((best_sock_inx == -1) ||
+			    (sock_gres->cnt_by_sock[s] >
+			     sock_gres->cnt_by_sock[best_sock_inx])) {
+				best_sock_inx = s;
 			}
 		}
 		while ((best_sock_inx != -1) && (add_gres > 0)) {
@@ -467,8 +465,8 @@ static sock_gres_t *_build_sock_gres_by_topo(
 				}
 			}
 		}
-		xfree(avail_sock_flag);
 	}
+	xfree(avail_sock_flag);
 
 	if (!match) {
 		gres_sock_delete(sock_gres);
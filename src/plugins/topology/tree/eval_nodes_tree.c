@@ -748,6 +748,7 @@ static int _eval_nodes_topo(topology_eval_t *topo_eval)
 	int       *switch_node_cnt = NULL;	/* total nodes on switch */
 	int       *switch_required = NULL;	/* set if has required node */
 	int *req_switch_required = NULL;
+	bool      *switch_empty = NULL;		/* no usable nodes on switch */
 	bitstr_t  *avail_nodes_bitmap = NULL;	/* nodes on any switch */
 	bitstr_t  *req_nodes_bitmap   = NULL;	/* required node bitmap */
 	bitstr_t  *req2_nodes_bitmap  = NULL;	/* required+lowest prio nodes */
@@ -893,6 +894,7 @@ static int _eval_nodes_topo(topology_eval_t *topo_eval)
 	switch_node_cnt    = xcalloc(switch_record_cnt, sizeof(int));
 	switch_required    = xcalloc(switch_record_cnt, sizeof(int));
 	req_switch_required = xcalloc(switch_record_cnt, sizeof(int));
+	switch_empty = xcalloc(switch_record_cnt, sizeof(bool));
 
 	for (i = 0, switch_ptr = switch_record_table; i < switch_record_cnt;
 	     i++, switch_ptr++) {
@@ -900,6 +902,15 @@ static int _eval_nodes_topo(topology_eval_t *topo_eval)
 		switch_node_bitmap[i] = bit_copy(switch_ptr->node_bitmap);
 		bit_and(switch_node_bitmap[i], topo_eval->node_map);
 		switch_node_cnt[i] = bit_set_count(switch_node_bitmap[i]);
+		/*
+		 * Switch bitmaps are only ever reduced from here on, so skip
+		 * any further work on switches without usable nodes, as most
+		 * leaf switches of a large and busy cluster are.
+		 */
+		if (!switch_node_cnt[i]) {
+			switch_empty[i] = true;
+			continue;
+		}
 		/*
 		 * Count total CPUs of the intersection of node_map and
 		 * switch_node_bitmap.
@@ -968,7 +979,7 @@ static int _eval_nodes_topo(topology_eval_t *topo_eval)
 	 * top level switch.
 	 */
 	for (i = 0; i < switch_record_cnt; i++) {
-		if (top_switch_inx != i) {
+		if ((top_switch_inx != i) && !switch_empty[i]) {
 			  bit_and(switch_node_bitmap[i],
 				  switch_node_bitmap[top_switch_inx]);
 		}
@@ -995,8 +1006,11 @@ static int _eval_nodes_topo(topology_eval_t *topo_eval)
 	start_node_map = bit_copy(topo_eval->node_map);
 	memcpy(req_switch_required, switch_required,
 	       switch_record_cnt * sizeof(int));
-	for (i = 0; i < switch_record_cnt; i++)
-		start_switch_node_bitmap[i] = bit_copy(switch_node_bitmap[i]);
+	for (i = 0; i < switch_record_cnt; i++) {
+		if (!switch_empty[i])
+			start_switch_node_bitmap[i] =
+				bit_copy(switch_node_bitmap[i]);
+	}
 
 try_again:
 	/*
@@ -1121,7 +1135,7 @@ try_again:
 
 		for (i = 0, switch_ptr = switch_record_table;
 		     i < switch_record_cnt; i++, switch_ptr++) {
-			if (switch_required[i])
+			if (switch_required[i] || switch_empty[i])
 				continue;
 			if (bit_overlap_any(req2_nodes_bitmap,
 					    switch_node_bitmap[i])) {
@@ -1155,6 +1169,10 @@ try_again:
 	avail_nodes_bitmap = bit_alloc(node_record_count);
 	for (i = 0, switch_ptr = switch_record_table; i < switch_record_cnt;
 	     i++, switch_ptr++) {
+		if (switch_empty[i]) {
+			switch_node_cnt[i] = 0;
+			continue;
+		}
 		bit_and(switch_node_bitmap[i], best_nodes_bitmap);
 		bit_or(avail_nodes_bitmap, switch_node_bitmap[i]);
 		switch_node_cnt[i] = bit_set_count(switch_node_bitmap[i]);
@@ -1296,7 +1314,8 @@ fini:
 		/* Count up leaf switches. */
 		for (i = 0, switch_ptr = switch_record_table;
 		     i < switch_record_cnt; i++, switch_ptr++) {
-			if (switch_record_table[i].level != 0)
+			if ((switch_record_table[i].level != 0) ||
+			    switch_empty[i])
 				continue;
 			if (bit_overlap_any(switch_node_bitmap[i], topo_eval->node_map))
 				leaf_switch_count++;
@@ -1327,10 +1346,13 @@ fini:
 				       switch_record_cnt * sizeof(int));
 				memset(avail_cpu_per_node, 0,
 				       node_record_count * sizeof(uint16_t));
-				for (i = 0; i < switch_record_cnt; i++)
+				for (i = 0; i < switch_record_cnt; i++) {
+					if (switch_empty[i])
+						continue;
 					bit_copybits(
 						switch_node_bitmap[i],
 						start_switch_node_bitmap[i]);
+				}
 				FREE_NULL_BITMAP(avail_nodes_bitmap);
 				FREE_NULL_BITMAP(req2_nodes_bitmap);
 				FREE_NULL_BITMAP(best_nodes_bitmap);
@@ -1369,6 +1391,7 @@ fini:
 	xfree(switch_node_cnt);
 	xfree(switch_required);
 	xfree(req_switch_required);
+	xfree(switch_empty);
 	xfree(switches_dist);
 	return rc;
 }
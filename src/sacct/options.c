@@ -43,6 +43,7 @@
 #include "src/common/proc_args.h"
 #include "src/common/read_config.h"
 #include "src/common/slurm_time.h"
+#include "src/common/uid.h"
 #include "src/common/xstring.h"
 #include "src/interfaces/data_parser.h"
 #include "src/interfaces/serializer.h"
@@ -1542,6 +1543,8 @@ extern void sacct_fini(void)
 	FREE_NULL_LIST(jobs);
 	FREE_NULL_LIST(g_qos_list);
 	FREE_NULL_LIST(g_tres_list);
+	uid_cache_clear();
+	gid_cache_clear();
 
 	if (params.opt_completion)
 		slurmdb_jobcomp_fini();
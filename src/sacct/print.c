@@ -917,11 +917,10 @@ extern void print_fields(type_t type, void *object)
 			default:
 				break;
 			}
-			tmp_char = gid_to_string(tmp_uint32);
+			tmp_char = gid_to_string_cached(tmp_uint32);
 			field->print_routine(field,
 					     tmp_char,
 					     (curr_inx == field_count));
-			xfree(tmp_char);
 			break;
 		case PRINT_JOBID:
 			if (type == JOBSTEP)
@@ -2037,16 +2036,13 @@ extern void print_fields(type_t type, void *object)
 					     (curr_inx == field_count));
 			break;
 		case PRINT_USER:
-		{
-			char *user = NULL;
 			switch(type) {
 			case JOB:
 				if (job->user)
 					tmp_char = job->user;
-				else {
-					user = uid_to_string(job->uid);
-					tmp_char = user;
-				}
+				else
+					tmp_char = uid_to_string_cached(
+						job->uid);
 				break;
 			case JOBCOMP:
 				tmp_char = job_comp->uid_name;
@@ -2058,9 +2054,7 @@ extern void print_fields(type_t type, void *object)
 			field->print_routine(field,
 					     tmp_char,
 					     (curr_inx == field_count));
-			xfree(user);
 			break;
-		}
 		case PRINT_USERCPU:
 			switch(type) {
 			case JOB:
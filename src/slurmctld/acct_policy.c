@@ -553,6 +553,40 @@ static int _find_used_limits_for_user(void *x, void *key)
 	return 0;
 }
 
+/*
+ * Same as acct_policy_get_acct_used_limits() but never add a record, so only
+ * a QOS read lock is needed. If no record exists yet, return "empty".
+ */
+static slurmdb_used_limits_t *_find_acct_used_limits(
+	List acct_limit_list, char *acct, slurmdb_used_limits_t *empty)
+{
+	slurmdb_used_limits_t *used_limits = NULL;
+
+	if (acct_limit_list)
+		used_limits = list_find_first_ro(acct_limit_list,
+						 _find_used_limits_for_acct,
+						 acct);
+
+	return used_limits ? used_limits : empty;
+}
+
+/*
+ * Same as acct_policy_get_user_used_limits() but never add a record, so only
+ * a QOS read lock is needed. If no record exists yet, return "empty".
+ */
+static slurmdb_used_limits_t *_find_user_used_limits(
+	List user_limit_list, uint32_t user_id, slurmdb_used_limits_t *empty)
+{
+	slurmdb_used_limits_t *used_limits = NULL;
+
+	if (user_limit_list)
+		used_limits = list_find_first_ro(user_limit_list,
+						 _find_used_limits_for_user,
+						 &user_id);
+
+	return used_limits ? used_limits : empty;
+}
+
 static bool _valid_job_assoc(job_record_t *job_ptr)
 {
 	slurmdb_assoc_rec_t assoc_rec;
@@ -1853,10 +1887,13 @@ static int _qos_policy_validate(job_desc_msg_t *job_desc,
 
 	if ((qos_out_ptr->max_submit_jobs_pa == INFINITE) &&
 	    (qos_ptr->max_submit_jobs_pa != INFINITE)) {
+		slurmdb_used_limits_t empty_limits = {
+			.acct = assoc_ptr->acct,
+		};
 		slurmdb_used_limits_t *used_limits =
-			acct_policy_get_acct_used_limits(
-				&qos_ptr->usage->acct_limit_list,
-				assoc_ptr->acct);
+			_find_acct_used_limits(
+				qos_ptr->usage->acct_limit_list,
+				assoc_ptr->acct, &empty_limits);
 
 		qos_out_ptr->max_submit_jobs_pa = qos_ptr->max_submit_jobs_pa;
 
@@ -1876,10 +1913,13 @@ static int _qos_policy_validate(job_desc_msg_t *job_desc,
 
 	if ((qos_out_ptr->max_submit_jobs_pu == INFINITE) &&
 	    (qos_ptr->max_submit_jobs_pu != INFINITE)) {
+		slurmdb_used_limits_t empty_limits = {
+			.uid = job_desc->user_id,
+		};
 		slurmdb_used_limits_t *used_limits =
-			acct_policy_get_user_used_limits(
-				&qos_ptr->usage->user_limit_list,
-				job_desc->user_id);
+			_find_user_used_limits(
+				qos_ptr->usage->user_limit_list,
+				job_desc->user_id, &empty_limits);
 
 		qos_out_ptr->max_submit_jobs_pu = qos_ptr->max_submit_jobs_pu;
 
@@ -1935,12 +1975,21 @@ static int _qos_job_runnable_pre_select(job_record_t *job_ptr,
 	uint32_t time_limit = NO_VAL;
 	int rc = true;
 	slurmdb_used_limits_t *used_limits = NULL, *used_limits_a = NULL;
-	bool safe_limits = false;
+	uint64_t empty_tres[slurmctld_tres_cnt];
 	slurmdb_assoc_rec_t *assoc_ptr = job_ptr->assoc_ptr;
+	slurmdb_used_limits_t empty_limits = {
+		.acct = assoc_ptr ? assoc_ptr->acct : NULL,
+		.tres = empty_tres,
+		.tres_run_mins = empty_tres,
+		.uid = job_ptr->user_id,
+	};
+	bool safe_limits = false;
 
 	if (!qos_ptr || !qos_out_ptr || !assoc_ptr)
 		return rc;
 
+	memset(empty_tres, 0, sizeof(empty_tres));
+
 	/*
 	 * check to see if we should be using safe limits, if so we
 	 * will only start a job if there are sufficient remaining
@@ -1951,13 +2000,13 @@ static int _qos_job_runnable_pre_select(job_record_t *job_ptr,
 
 	wall_mins = qos_ptr->usage->grp_used_wall / 60;
 
-	used_limits_a =	acct_policy_get_acct_used_limits(
-		&qos_ptr->usage->acct_limit_list,
-		assoc_ptr->acct);
+	used_limits_a =	_find_acct_used_limits(
+		qos_ptr->usage->acct_limit_list,
+		assoc_ptr->acct, &empty_limits);
 
-	used_limits = acct_policy_get_user_used_limits(
-		&qos_ptr->usage->user_limit_list,
-		job_ptr->user_id);
+	used_limits = _find_user_used_limits(
+		qos_ptr->usage->user_limit_list,
+		job_ptr->user_id, &empty_limits);
 
 
 	/* we don't need to check grp_tres_mins here */
@@ -2135,10 +2184,17 @@ static int _qos_job_runnable_post_select(job_record_t *job_ptr,
 	uint64_t tres_run_mins[slurmctld_tres_cnt];
 	uint64_t orig_node_cnt;
 	slurmdb_used_limits_t *used_limits = NULL, *used_limits_a = NULL;
+	uint64_t empty_tres[slurmctld_tres_cnt];
+	slurmdb_assoc_rec_t *assoc_ptr = job_ptr->assoc_ptr;
+	slurmdb_used_limits_t empty_limits = {
+		.acct = assoc_ptr ? assoc_ptr->acct : NULL,
+		.tres = empty_tres,
+		.tres_run_mins = empty_tres,
+		.uid = job_ptr->user_id,
+	};
 	bool safe_limits = false;
 	int rc = true, i, tres_pos = 0;
 	acct_policy_tres_usage_t tres_usage;
-	slurmdb_assoc_rec_t *assoc_ptr = job_ptr->assoc_ptr;
 	double usage_factor = 1.0;
 
 	if (!qos_ptr || !qos_out_ptr || !assoc_ptr)
@@ -2155,6 +2211,7 @@ static int _qos_job_runnable_post_select(job_record_t *job_ptr,
 	/* clang needs this memset to avoid a warning */
 	memset(tres_run_mins, 0, sizeof(tres_run_mins));
 	memset(tres_usage_mins, 0, sizeof(tres_usage_mins));
+	memset(empty_tres, 0, sizeof(empty_tres));
 	if (job_ptr->qos_ptr &&
 	    (job_ptr->qos_ptr->usage_factor >= 0))
 		usage_factor = job_ptr->qos_ptr->usage_factor;
@@ -2175,13 +2232,13 @@ static int _qos_job_runnable_post_select(job_record_t *job_ptr,
 		}
 	}
 
-	used_limits_a =	acct_policy_get_acct_used_limits(
-		&qos_ptr->usage->acct_limit_list,
-		assoc_ptr->acct);
+	used_limits_a =	_find_acct_used_limits(
+		qos_ptr->usage->acct_limit_list,
+		assoc_ptr->acct, &empty_limits);
 
-	used_limits = acct_policy_get_user_used_limits(
-		&qos_ptr->usage->user_limit_list,
-		job_ptr->user_id);
+	used_limits = _find_user_used_limits(
+		qos_ptr->usage->user_limit_list,
+		job_ptr->user_id, &empty_limits);
 
 	tres_usage = _validate_tres_usage_limits_for_qos(
 		&tres_pos, qos_ptr->grp_tres_mins_ctld,
@@ -2913,7 +2970,7 @@ static bool _acct_policy_validate(job_desc_msg_t *job_desc,
 	char *user_name = NULL;
 	bool rc = true;
 	assoc_mgr_lock_t locks =
-		{ .assoc = READ_LOCK, .qos = WRITE_LOCK, .tres = READ_LOCK };
+		{ .assoc = READ_LOCK, .qos = READ_LOCK, .tres = READ_LOCK };
 	bool strict_checking;
 	double limit_factor = -1.0;
 	uint64_t grp_tres_ctld[slurmctld_tres_cnt];
@@ -2936,7 +2993,7 @@ static bool _acct_policy_validate(job_desc_msg_t *job_desc,
 		assoc_mgr_lock(&locks);
 
 	xassert(verify_assoc_lock(ASSOC_LOCK, READ_LOCK));
-	xassert(verify_assoc_lock(QOS_LOCK, WRITE_LOCK));
+	xassert(verify_assoc_lock(QOS_LOCK, READ_LOCK));
 	xassert(verify_assoc_lock(TRES_LOCK, READ_LOCK));
 
 	assoc_mgr_set_qos_tres_cnt(&qos_rec);
@@ -3298,7 +3355,7 @@ extern bool acct_policy_validate(job_desc_msg_t *job_desc,
 {
 	int rc = true;
 	assoc_mgr_lock_t locks =
-		{ .assoc = READ_LOCK, .qos = WRITE_LOCK, .tres = READ_LOCK };
+		{ .assoc = READ_LOCK, .qos = READ_LOCK, .tres = READ_LOCK };
 	acct_policy_validate_args_t args = {
 		.acct_policy_limit_set = acct_policy_limit_set,
 		.assoc_in = assoc_in, .job_desc = job_desc,
@@ -3474,7 +3531,7 @@ extern bool acct_policy_job_runnable_pre_select(job_record_t *job_ptr,
 			 * parent or not
 			 */
 	assoc_mgr_lock_t locks =
-		{ .assoc = READ_LOCK, .qos = WRITE_LOCK, .tres = READ_LOCK };
+		{ .assoc = READ_LOCK, .qos = READ_LOCK, .tres = READ_LOCK };
 
 	/* check to see if we are enforcing associations */
 	if (!accounting_enforce)
@@ -3714,7 +3771,7 @@ extern bool acct_policy_job_runnable_post_select(job_record_t *job_ptr,
 			 * parent or not
 			 */
 	assoc_mgr_lock_t locks =
-		{ .assoc = READ_LOCK, .qos = WRITE_LOCK, .tres = READ_LOCK };
+		{ .assoc = READ_LOCK, .qos = READ_LOCK, .tres = READ_LOCK };
 
 	xassert(job_ptr);
 	xassert(job_ptr->part_ptr);
@@ -4291,7 +4348,7 @@ extern bool acct_policy_job_time_out(job_record_t *job_ptr)
 	slurmdb_qos_rec_t qos_rec;
 	slurmdb_assoc_rec_t *assoc = NULL;
 	assoc_mgr_lock_t locks =
-		{ .assoc = READ_LOCK, .qos = WRITE_LOCK, .tres = READ_LOCK };
+		{ .assoc = READ_LOCK, .qos = READ_LOCK, .tres = READ_LOCK };
 	time_t now;
 	int i, tres_pos = 0;
 	acct_policy_tres_usage_t tres_usage;
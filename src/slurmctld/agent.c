@@ -222,7 +222,9 @@ static pthread_mutex_t retry_mutex = PTHREAD_MUTEX_INITIALIZER;
 static List defer_list = NULL;		/* agent_arg_t list for requests
 					 * requiring job write lock */
 static List mail_list = NULL;		/* pending e-mail requests */
-static List retry_list = NULL;		/* agent_arg_t list for retry */
+static List requeue_list = NULL;	/* agent_arg_t list for retry,
+					 * ordered by last_attempt */
+static List retry_list = NULL;		/* agent_arg_t list never tried */
 
 static list_t *update_node_list = NULL;	/* node list for update */
 static pthread_mutex_t update_nodes_mutex = PTHREAD_MUTEX_INITIALIZER;
@@ -1428,9 +1430,9 @@ static void _queue_agent_retry(agent_info_t * agent_info_ptr, int count)
 	queued_req_ptr->agent_arg_ptr = agent_arg_ptr;
 	queued_req_ptr->last_attempt  = time(NULL);
 	slurm_mutex_lock(&retry_mutex);
-	if (retry_list == NULL)
-		retry_list = list_create(_list_delete_retry);
-	list_append(retry_list, queued_req_ptr);
+	if (requeue_list == NULL)
+		requeue_list = list_create(_list_delete_retry);
+	list_append(requeue_list, queued_req_ptr);
 	slurm_mutex_unlock(&retry_mutex);
 }
 
@@ -1613,8 +1615,12 @@ extern void agent_pack_pending_rpc_stats(buf_t *buffer)
 	}
 
 	slurm_mutex_lock(&retry_mutex);
-	if (retry_list) {
-		list_iter = list_iterator_create(retry_list);
+	for (int l = 0; l < 2; l++) {
+		List pend_list = l ? requeue_list : retry_list;
+
+		if (!pend_list)
+			continue;
+		list_iter = list_iterator_create(pend_list);
 		/* iterate through list, find type slot or make a new one */
 		while ((queued_req_ptr = list_next(list_iter))) {
 			agent_arg_ptr = queued_req_ptr->agent_arg_ptr;
@@ -1711,9 +1717,7 @@ static int _find_request(void *x, void *key)
 	queued_request_t *queued_req_ptr = x;
 	double *before = key;
 
-	if (!(*before) && queued_req_ptr->last_attempt == 0)
-		return 1;
-	else if (queued_req_ptr->last_attempt < *before)
+	if (queued_req_ptr->last_attempt < *before)
 		return 1;
 
 	return 0;
@@ -1731,25 +1735,33 @@ static void _agent_retry(int min_wait, bool mail_too)
 
 next:
 	slurm_mutex_lock(&retry_mutex);
-	if (retry_list && !list_size) {
+	if ((retry_list || requeue_list) && !list_size) {
 		static time_t last_msg_time = (time_t) 0;
 		uint32_t msg_type[5] = {0, 0, 0, 0, 0};
 		int i = 0;
-		list_size = list_count(retry_list);
+		list_size = retry_list_size();
 		if (((list_size > 100) &&
 		     (difftime(now, last_msg_time) > 300)) ||
 		    ((list_size > 0) &&
 		     (slurm_conf.debug_flags & DEBUG_FLAG_AGENT))) {
 			/* Note sizable backlog (retry_list_size()) of work */
 			list_itr_t *retry_iter;
-			retry_iter = list_iterator_create(retry_list);
-			while ((queued_req_ptr = list_next(retry_iter))) {
-				agent_arg_ptr = queued_req_ptr->agent_arg_ptr;
-				msg_type[i++] = agent_arg_ptr->msg_type;
-				if (i == 5)
-					break;
+			for (int l = 0; (l < 2) && (i < 5); l++) {
+				List pend_list = l ? requeue_list : retry_list;
+
+				if (!pend_list)
+					continue;
+				retry_iter = list_iterator_create(pend_list);
+				while ((queued_req_ptr =
+					list_next(retry_iter))) {
+					agent_arg_ptr =
+						queued_req_ptr->agent_arg_ptr;
+					msg_type[i++] = agent_arg_ptr->msg_type;
+					if (i == 5)
+						break;
+				}
+				list_iterator_destroy(retry_iter);
 			}
-			list_iterator_destroy(retry_iter);
 			info("   retry_list retry_list_size:%d msg_type=%s,%s,%s,%s,%s",
 			     list_size, rpc_num2string(msg_type[0]),
 			     rpc_num2string(msg_type[1]),
@@ -1767,20 +1779,23 @@ next:
 		return;
 	}
 
-	if (retry_list) {
-		/* first try to find a new (never tried) record */
-		double key = 0;
-
-		queued_req_ptr = list_remove_first(retry_list, _find_request,
-						   &key);
-	}
+	/*
+	 * First take a new (never tried) record. These are kept apart from
+	 * requeued records so this is O(1) regardless of the retry backlog.
+	 */
+	queued_req_ptr = NULL;
+	if (retry_list)
+		queued_req_ptr = list_pop(retry_list);
 
-	if (retry_list && (queued_req_ptr == NULL)) {
-		/* now try to find a requeue request that is
-		 * relatively old */
+	if (requeue_list && (queued_req_ptr == NULL)) {
+		/*
+		 * Now try to find a requeue request that is relatively old.
+		 * Records are appended as they are requeued, so the match is
+		 * normally found at the head of the list.
+		 */
 		double before = difftime(now, min_wait);
 
-		queued_req_ptr = list_remove_first(retry_list, _find_request,
+		queued_req_ptr = list_remove_first(requeue_list, _find_request,
 						   &before);
 	}
 	slurm_mutex_unlock(&retry_mutex);
@@ -1872,9 +1887,10 @@ extern void agent_purge(void)
 {
 	int i;
 
-	if (retry_list) {
+	if (retry_list || requeue_list) {
 		slurm_mutex_lock(&retry_mutex);
 		FREE_NULL_LIST(retry_list);
+		FREE_NULL_LIST(requeue_list);
 		slurm_mutex_unlock(&retry_mutex);
 	}
 	if (defer_list) {
@@ -2427,12 +2443,16 @@ static int _signal_defer(queued_request_t *queued_req_ptr)
 	return 1;
 }
 
-/* Return length of agent's retry_list */
+/* Return count of pending agent requests (new and requeued) */
 extern int retry_list_size(void)
 {
-	if (retry_list == NULL)
-		return 0;
-	return list_count(retry_list);
+	int cnt = 0;
+
+	if (retry_list)
+		cnt += list_count(retry_list);
+	if (requeue_list)
+		cnt += list_count(requeue_list);
+	return cnt;
 }
 
 static void _reboot_from_ctld(agent_arg_t *agent_arg_ptr)
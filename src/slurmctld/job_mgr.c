@@ -4339,6 +4339,56 @@ void init_job_conf(void)
 	}
 }
 
+/*
+ * Move every record of the job and job array hash tables into new tables of
+ * size new_size. Only records already in a table are relinked, so a table's
+ * membership does not change.
+ */
+static void _resize_job_hash(int new_size)
+{
+	job_record_t **old_hash = job_hash;
+	job_record_t **old_array_hash_j = job_array_hash_j;
+	job_record_t **old_array_hash_t = job_array_hash_t;
+	job_record_t *job_ptr, *next_ptr;
+	int inx, old_size = hash_table_size;
+
+	hash_table_size = new_size;
+	job_hash = xcalloc(hash_table_size, sizeof(job_record_t *));
+	job_array_hash_j = xcalloc(hash_table_size, sizeof(job_record_t *));
+	job_array_hash_t = xcalloc(hash_table_size, sizeof(job_record_t *));
+
+	for (int i = 0; i < old_size; i++) {
+		for (job_ptr = old_hash[i]; job_ptr; job_ptr = next_ptr) {
+			next_ptr = job_ptr->job_next;
+			inx = JOB_HASH_INX(job_ptr->job_id);
+			job_ptr->job_next = job_hash[inx];
+			job_hash[inx] = job_ptr;
+		}
+		for (job_ptr = old_array_hash_j[i]; job_ptr;
+		     job_ptr = next_ptr) {
+			next_ptr = job_ptr->job_array_next_j;
+			inx = JOB_HASH_INX(job_ptr->array_job_id);
+			job_ptr->job_array_next_j = job_array_hash_j[inx];
+			job_array_hash_j[inx] = job_ptr;
+		}
+		for (job_ptr = old_array_hash_t[i]; job_ptr;
+		     job_ptr = next_ptr) {
+			next_ptr = job_ptr->job_array_next_t;
+			inx = JOB_ARRAY_HASH_INX(job_ptr->array_job_id,
+						 job_ptr->array_task_id);
+			job_ptr->job_array_next_t = job_array_hash_t[inx];
+			job_array_hash_t[inx] = job_ptr;
+		}
+	}
+
+	xfree(old_hash);
+	xfree(old_array_hash_j);
+	xfree(old_array_hash_t);
+
+	verbose("%s: job hash tables resized from %d to %d",
+		__func__, old_size, hash_table_size);
+}
+
 /*
  * rehash_jobs - Create or rebuild the job hash table.
  */
@@ -4354,13 +4404,12 @@ extern void rehash_jobs(void)
 					   sizeof(job_record_t *));
 		job_array_hash_t = xcalloc(hash_table_size,
 					   sizeof(job_record_t *));
-	} else if (hash_table_size < (slurm_conf.max_job_cnt / 2)) {
-		/* If the MaxJobCount grows by too much, the hash table will
-		 * be ineffective without rebuilding. We don't presently bother
-		 * to rebuild the hash table, but cut MaxJobCount back as
-		 * needed. */
-		error ("MaxJobCount reset too high, restart slurmctld");
-		slurm_conf.max_job_cnt = hash_table_size;
+	} else if (hash_table_size < slurm_conf.max_job_cnt) {
+		/*
+		 * MaxJobCount grew on reconfigure. Rebuild the hash tables at
+		 * the new size so the chains stay short.
+		 */
+		_resize_job_hash(slurm_conf.max_job_cnt);
 	}
 }
 
@@ -537,9 +537,8 @@ extern void find_feature_nodes(List feature_list, bool can_reboot)
 	while ((job_feat_ptr = list_next(feat_iter))) {
 		FREE_NULL_BITMAP(job_feat_ptr->node_bitmap_active);
 		FREE_NULL_BITMAP(job_feat_ptr->node_bitmap_avail);
-		node_feat_ptr = list_find_first(active_feature_list,
-						list_find_feature,
-						job_feat_ptr->name);
+		node_feat_ptr = find_feature_record(active_feature_list,
+						    job_feat_ptr->name);
 		if (node_feat_ptr && node_feat_ptr->node_bitmap) {
 			job_feat_ptr->node_bitmap_active =
 				bit_copy(node_feat_ptr->node_bitmap);
@@ -548,9 +547,8 @@ extern void find_feature_nodes(List feature_list, bool can_reboot)
 				bit_alloc(node_record_count);
 		}
 		if (can_reboot && job_feat_ptr->changeable) {
-			node_feat_ptr = list_find_first(avail_feature_list,
-							list_find_feature,
-							job_feat_ptr->name);
+			node_feat_ptr = find_feature_record(
+				avail_feature_list, job_feat_ptr->name);
 			if (node_feat_ptr && node_feat_ptr->node_bitmap) {
 				job_feat_ptr->node_bitmap_avail =
 					bit_copy(node_feat_ptr->node_bitmap);
@@ -707,8 +705,7 @@ extern bitstr_t *build_active_feature_bitmap2(char *reboot_features)
 	tok = strtok_r(tmp, delim, &save_ptr);
 
 	while (tok) {
-		node_feat_ptr = list_find_first(active_feature_list,
-						list_find_feature, tok);
+		node_feat_ptr = find_feature_record(active_feature_list, tok);
 		if (node_feat_ptr && node_feat_ptr->node_bitmap) {
 			/*
 			 * Found feature, add nodes with this feature and
@@ -59,6 +59,7 @@
 #include "src/common/slurm_protocol_pack.h"
 #include "src/common/slurm_resource_info.h"
 #include "src/common/uid.h"
+#include "src/common/xhash.h"
 #include "src/common/xstring.h"
 
 #include "src/interfaces/burst_buffer.h"
@@ -93,12 +94,15 @@ List part_list = NULL;			/* partition list */
 char *default_part_name = NULL;		/* name of default partition */
 part_record_t *default_part_loc = NULL;	/* default partition location */
 time_t last_part_update = (time_t) 0;	/* time of last update to partition records */
+static xhash_t *part_hash = NULL;	/* part_list records indexed by name */
 uint16_t part_max_priority = DEF_PART_MAX_PRIORITY;
 
 static int    _dump_part_state(void *x, void *arg);
 static void   _list_delete_part(void *part_entry);
 static int    _match_part_ptr(void *part_ptr, void *key);
 static buf_t *_open_part_state_file(char **state_file);
+static void   _part_hash_identity(void *item, const char **key,
+				  uint32_t *key_len);
 static void   _unlink_free_nodes(bitstr_t *old_bitmap, part_record_t *part_ptr);
 
 static int _calc_part_tres(void *x, void *arg)
@@ -385,10 +389,26 @@ part_record_t *create_part_record(const char *name)
 	part_ptr->name = xstrdup(name);
 
 	list_append(part_list, part_ptr);
+	if (!part_hash)
+		part_hash = xhash_init(_part_hash_identity, NULL);
+	if (!xhash_get_str(part_hash, part_ptr->name))
+		xhash_add(part_hash, part_ptr);
 
 	return part_ptr;
 }
 
+/*
+ * xhash helper function to index part_record per name field in part_hash
+ */
+static void _part_hash_identity(void *item, const char **key,
+				uint32_t *key_len)
+{
+	part_record_t *part_ptr = item;
+
+	*key = part_ptr->name;
+	*key_len = strlen(part_ptr->name);
+}
+
 /* dump_all_part_state - save the state of all partitions to file */
 int dump_all_part_state(void)
 {
@@ -685,8 +705,7 @@ int load_all_part_state(void)
 		}
 
 		/* find record and perform update */
-		part_ptr = list_find_first(part_list, &list_find_part,
-					   part_name);
+		part_ptr = find_part_record(part_name);
 		part_cnt++;
 		if (part_ptr == NULL) {
 			info("%s: partition %s missing from configuration file",
@@ -795,7 +814,9 @@ part_record_t *find_part_record(char *name)
 		error("part_list is NULL");
 		return NULL;
 	}
-	return list_find_first(part_list, &list_find_part, name);
+	if (!name || !part_hash)
+		return NULL;
+	return xhash_get_str(part_hash, name);
 }
 
 /*
@@ -842,7 +863,7 @@ extern List get_part_list(char *name, char **err_part)
 	tmp_name = xstrdup(name);
 	token = strtok_r(tmp_name, ",", &last);
 	while (token) {
-		part_ptr = list_find_first(part_list, &list_find_part, token);
+		part_ptr = find_part_record(token);
 		if (part_ptr) {
 			if (job_part_list == NULL) {
 				job_part_list = list_create(NULL);
@@ -919,6 +940,9 @@ static void _list_delete_part(void *part_entry)
 	xassert(part_ptr->magic == PART_MAGIC);
 	part_ptr->magic = ~PART_MAGIC;
 
+	if (xhash_get_str(part_hash, part_ptr->name) == part_ptr)
+		xhash_delete_str(part_hash, part_ptr->name);
+
 	for (i = 0; (node_ptr = next_node(&i)); i++) {
 		for (j=0; j<node_ptr->part_cnt; j++) {
 			if (node_ptr->part_pptr[j] != part_ptr)
@@ -1260,8 +1284,7 @@ extern int update_part(update_part_msg_t * part_desc, bool create_flag)
 	}
 
 	error_code = SLURM_SUCCESS;
-	part_ptr = list_find_first(part_list, &list_find_part,
-				   part_desc->name);
+	part_ptr = find_part_record(part_desc->name);
 
 	if (create_flag) {
 		if (part_ptr) {
@@ -2100,6 +2123,7 @@ void load_part_uid_allow_list(bool force)
 void part_fini (void)
 {
 	FREE_NULL_LIST(part_list);
+	xhash_free(part_hash);
 	default_part_loc = NULL;
 }
 
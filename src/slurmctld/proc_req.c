@@ -119,6 +119,7 @@ static uint32_t rpc_user_cnt[RPC_USER_SIZE] = { 0 };
 static uint64_t rpc_user_time[RPC_USER_SIZE] = { 0 };
 
 static bool do_post_rpc_node_registration = false;
+static bool do_post_rpc_epilog_complete = false;
 
 bool running_configless = false;
 static pthread_rwlock_t configless_lock = PTHREAD_RWLOCK_INITIALIZER;
@@ -743,7 +744,11 @@ static int _make_step_cred(step_record_t *step_ptr, slurm_cred_t **slurm_cred,
 					    &cred_arg.step_mem_alloc_size);
 	}
 
-	*slurm_cred = slurm_cred_create(&cred_arg, true, protocol_version);
+	/*
+	 * Signing may block on munged, so leave it to the caller to do once
+	 * the job write lock is released. See slurm_cred_sign().
+	 */
+	*slurm_cred = slurm_cred_create(&cred_arg, false, protocol_version);
 
 	xfree(cred_arg.job_mem_alloc);
 	xfree(cred_arg.job_mem_alloc_rep_count);
@@ -1820,6 +1825,24 @@ static void _slurm_rpc_dump_partitions(slurm_msg_t *msg)
 	}
 }
 
+/*
+ * Run the scheduler once after a batch of queued epilog complete RPCs, rather
+ * than once for every node of every job that finished.
+ */
+static void _slurm_post_rpc_epilog_complete(void)
+{
+	if (!do_post_rpc_epilog_complete)
+		return;
+	do_post_rpc_epilog_complete = false;
+
+	if (!LOTS_OF_AGENTS && !xstrcasestr(slurm_conf.sched_params, "defer"))
+		schedule(false);	/* Has own locking */
+	else
+		queue_job_scheduler();
+	schedule_node_save();		/* Has own locking */
+	schedule_job_save();		/* Has own locking */
+}
+
 /* _slurm_rpc_epilog_complete - process RPC noting the completion of
  * the epilog denoting the completion of a job it its entirety */
 static void _slurm_rpc_epilog_complete(slurm_msg_t *msg)
@@ -1875,6 +1898,9 @@ static void _slurm_rpc_epilog_complete(slurm_msg_t *msg)
 	if (!(msg->flags & CTLD_QUEUE_PROCESSING)) {
 		unlock_slurmctld(job_write_lock);
 		_throttle_fini(&active_rpc_cnt);
+	} else if (run_scheduler) {
+		/* Deferred to _slurm_post_rpc_epilog_complete() */
+		do_post_rpc_epilog_complete = true;
 	}
 
 	END_TIMER2(__func__);
@@ -2245,7 +2271,8 @@ static void _slurm_rpc_dump_batch_script(slurm_msg_t *msg)
 	}
 }
 
-static void _kill_step_on_msg_fail(step_complete_msg_t *req, slurm_msg_t *msg)
+static void _kill_step_on_msg_fail(step_complete_msg_t *req, slurm_msg_t *msg,
+				   const char *reason)
 {
 	static int active_rpc_cnt = 0;
 	int rc, rem;
@@ -2260,8 +2287,8 @@ static void _kill_step_on_msg_fail(step_complete_msg_t *req, slurm_msg_t *msg)
 
 	/* init */
 	START_TIMER;
-	error("Step creation timed out: Deallocating %ps nodes %u-%u",
-	      &req->step_id, req->range_first, req->range_last);
+	error("%s: Deallocating %ps nodes %u-%u",
+	      reason, &req->step_id, req->range_first, req->range_last);
 
 	if (!(msg->flags & CTLD_QUEUE_PROCESSING)) {
 		_throttle_start(&active_rpc_cnt);
@@ -2370,6 +2397,7 @@ static void _slurm_rpc_job_step_create(slurm_msg_t *msg)
 		slurm_step_layout_t *step_layout = NULL;
 		dynamic_plugin_data_t *select_jobinfo = NULL;
 		dynamic_plugin_data_t *switch_job = NULL;
+		step_complete_msg_t req;
 
 		log_flag(STEPS, "%s: %pS %s %s",
 			 __func__, step_rec, req_step_msg->node_list, TIME_STR);
@@ -2401,24 +2429,35 @@ static void _slurm_rpc_job_step_create(slurm_msg_t *msg)
 						   &switch_job);
 		job_step_resp.switch_job = switch_job;
 
-		if (!(msg->flags & CTLD_QUEUE_PROCESSING)) {
-			unlock_slurmctld(job_write_lock);
-			_throttle_fini(&active_rpc_cnt);
-		}
 		response_init(&resp, msg, RESPONSE_JOB_STEP_CREATE,
 			      &job_step_resp);
 		resp.protocol_version = step_rec->start_protocol_ver;
 
-		if (slurm_send_node_msg(msg->conn_fd, &resp) < 0) {
-			step_complete_msg_t req;
+		memset(&req, 0, sizeof(req));
+		req.step_id = step_rec->step_id;
+		req.jobacct = step_rec->jobacct;
+		req.step_rc = SIGKILL;
+		req.range_first = 0;
+		req.range_last = step_layout->node_cnt - 1;
 
-			memset(&req, 0, sizeof(req));
-			req.step_id = step_rec->step_id;
-			req.jobacct = step_rec->jobacct;
-			req.step_rc = SIGKILL;
-			req.range_first = 0;
-			req.range_last = step_layout->node_cnt - 1;
-			_kill_step_on_msg_fail(&req, msg);
+		if (!(msg->flags & CTLD_QUEUE_PROCESSING)) {
+			unlock_slurmctld(job_write_lock);
+			_throttle_fini(&active_rpc_cnt);
+		}
+
+		/*
+		 * Sign the credential without the job write lock. When the RPC
+		 * queue processes this RPC it holds the slurmctld locks for the
+		 * whole handler, so signing and sending the response still
+		 * happen under them in that case.
+		 */
+		if (slurm_cred_sign(slurm_cred)) {
+			slurm_send_rc_msg(msg, ESLURM_INVALID_JOB_CREDENTIAL);
+			_kill_step_on_msg_fail(&req, msg,
+					       "Step credential signing failed");
+		} else if (slurm_send_node_msg(msg->conn_fd, &resp) < 0) {
+			_kill_step_on_msg_fail(&req, msg,
+					       "Step creation timed out");
 		}
 
 		slurm_cred_destroy(slurm_cred);
@@ -2588,8 +2627,8 @@ static bool _node_has_feature(node_record_t *node_ptr, char *feature)
 {
 	node_feature_t *node_feature;
 
-	if ((node_feature = list_find_first(active_feature_list,
-					    list_find_feature, feature))) {
+	if ((node_feature = find_feature_record(active_feature_list,
+						feature))) {
 		if (bit_test(node_feature->node_bitmap, node_ptr->index))
 		    return true;
 	}
@@ -6553,6 +6592,13 @@ slurmctld_rpc_t slurmctld_rpcs[] =
 	},{
 		.msg_type = MESSAGE_EPILOG_COMPLETE,
 		.func = _slurm_rpc_epilog_complete,
+		.post_func = _slurm_post_rpc_epilog_complete,
+		.queue_enabled = true,
+		.locks = {
+			.conf = READ_LOCK,
+			.job = WRITE_LOCK,
+			.node = WRITE_LOCK,
+		},
 	},{
 		.msg_type = REQUEST_CANCEL_JOB_STEP,
 		.func = _slurm_rpc_job_step_kill,
@@ -59,6 +59,7 @@
 #include "src/common/read_config.h"
 #include "src/common/slurm_rlimits_info.h"
 #include "src/common/strnatcmp.h"
+#include "src/common/xhash.h"
 #include "src/common/xstring.h"
 
 #include "src/interfaces/burst_buffer.h"
@@ -100,12 +101,32 @@ List avail_feature_list;	/* list of available features_records */
 bool node_features_updated = true;
 bool slurmctld_init_db = true;
 
+/*
+ * Name indexes of active_feature_list and avail_feature_list. Records are
+ * only ever appended to these lists or freed along with the whole list, so an
+ * index stays valid while its list, record count and the global count of
+ * freed records are unchanged.
+ */
+typedef struct {
+	uint32_t del_cnt;
+	xhash_t *hash;
+	list_t *list;
+	int rec_cnt;
+} feature_index_t;
+
+static feature_index_t active_feature_index;
+static feature_index_t avail_feature_index;
+static uint32_t feature_del_cnt = 0;
+static pthread_mutex_t feature_index_mutex = PTHREAD_MUTEX_INITIALIZER;
+
 static void _acct_restore_active_jobs(void);
 static void _add_config_feature(List feature_list, char *feature,
 				bitstr_t *node_bitmap);
 static void _add_config_feature_inx(List feature_list, char *feature,
 				    int node_inx);
 static void _build_bitmaps(void);
+static void _feature_index_append(List feature_list,
+				  node_feature_t *feature_ptr);
 static void _gres_reconfig(void);
 static void _init_all_slurm_conf(void);
 static void _list_delete_feature(void *feature_entry);
@@ -260,9 +281,8 @@ static void _add_nodes_with_feature(hostlist_t *hl, char *feature)
 	if (avail_feature_list) {
 		char *feature_nodes;
 		node_feature_t *node_feat_ptr;
-		if (!(node_feat_ptr = list_find_first(avail_feature_list,
-						      list_find_feature,
-						      feature))) {
+		if (!(node_feat_ptr = find_feature_record(avail_feature_list,
+							  feature))) {
 			debug2("unable to find nodeset feature '%s'", feature);
 			return;
 		}
@@ -793,7 +813,7 @@ static int _build_single_partitionline_info(slurm_conf_partition_t *part)
 {
 	part_record_t *part_ptr;
 
-	if (list_find_first(part_list, &list_find_part, part->name))
+	if (find_part_record(part->name))
 		fatal("%s: duplicate entry for partition %s",
 		      __func__, part->name);
 
@@ -1823,26 +1843,17 @@ static void _add_config_feature(List feature_list, char *feature,
 				bitstr_t *node_bitmap)
 {
 	node_feature_t *feature_ptr;
-	list_itr_t *feature_iter;
-	bool match = false;
 
 	/* If feature already in avail_feature_list, just update the bitmap */
-	feature_iter = list_iterator_create(feature_list);
-	while ((feature_ptr = list_next(feature_iter))) {
-		if (xstrcmp(feature, feature_ptr->name))
-			continue;
+	if ((feature_ptr = find_feature_record(feature_list, feature))) {
 		bit_or(feature_ptr->node_bitmap, node_bitmap);
-		match = true;
-		break;
-	}
-	list_iterator_destroy(feature_iter);
-
-	if (!match) {	/* Need to create new avail_feature_list record */
+	} else {	/* Need to create new avail_feature_list record */
 		feature_ptr = xmalloc(sizeof(node_feature_t));
 		feature_ptr->magic = FEATURE_MAGIC;
 		feature_ptr->name = xstrdup(feature);
 		feature_ptr->node_bitmap = bit_copy(node_bitmap);
 		list_append(feature_list, feature_ptr);
+		_feature_index_append(feature_list, feature_ptr);
 	}
 }
 
@@ -1855,30 +1866,104 @@ static void _add_config_feature_inx(List feature_list, char *feature,
 				    int node_inx)
 {
 	node_feature_t *feature_ptr;
-	list_itr_t *feature_iter;
-	bool match = false;
 
 	/* If feature already in avail_feature_list, just update the bitmap */
-	feature_iter = list_iterator_create(feature_list);
-	while ((feature_ptr = list_next(feature_iter))) {
-		if (xstrcmp(feature, feature_ptr->name))
-			continue;
+	if ((feature_ptr = find_feature_record(feature_list, feature))) {
 		bit_set(feature_ptr->node_bitmap, node_inx);
-		match = true;
-		break;
-	}
-	list_iterator_destroy(feature_iter);
-
-	if (!match) {	/* Need to create new avail_feature_list record */
+	} else {	/* Need to create new avail_feature_list record */
 		feature_ptr = xmalloc(sizeof(node_feature_t));
 		feature_ptr->magic = FEATURE_MAGIC;
 		feature_ptr->name = xstrdup(feature);
 		feature_ptr->node_bitmap = bit_alloc(node_record_count);
 		bit_set(feature_ptr->node_bitmap, node_inx);
 		list_append(feature_list, feature_ptr);
+		_feature_index_append(feature_list, feature_ptr);
 	}
 }
 
+static void _feature_hash_identity(void *item, const char **key,
+				   uint32_t *key_len)
+{
+	node_feature_t *feature_ptr = item;
+
+	*key = feature_ptr->name;
+	*key_len = strlen(feature_ptr->name);
+}
+
+static feature_index_t *_feature_index(List feature_list)
+{
+	if (!feature_list)
+		return NULL;
+	if (feature_list == active_feature_list)
+		return &active_feature_index;
+	if (feature_list == avail_feature_list)
+		return &avail_feature_index;
+	return NULL;
+}
+
+static int _feature_index_add(void *x, void *arg)
+{
+	node_feature_t *feature_ptr = x;
+	xhash_t *hash = arg;
+
+	/* Keep the first record of a name, as list_find_feature() would */
+	if (!xhash_get_str(hash, feature_ptr->name))
+		xhash_add(hash, feature_ptr);
+	return 0;
+}
+
+/* Rebuild the index if its list changed. Call with feature_index_mutex */
+static void _feature_index_sync(feature_index_t *index, List feature_list)
+{
+	int rec_cnt = list_count(feature_list);
+
+	if (index->hash && (index->list == feature_list) &&
+	    (index->rec_cnt == rec_cnt) && (index->del_cnt == feature_del_cnt))
+		return;
+
+	xhash_free(index->hash);
+	index->hash = xhash_init(_feature_hash_identity, NULL);
+	list_for_each(feature_list, _feature_index_add, index->hash);
+	index->list = feature_list;
+	index->rec_cnt = rec_cnt;
+	index->del_cnt = feature_del_cnt;
+}
+
+/* Add a record just appended to feature_list to its up to date index */
+static void _feature_index_append(List feature_list,
+				  node_feature_t *feature_ptr)
+{
+	feature_index_t *index = _feature_index(feature_list);
+
+	if (!index)
+		return;
+
+	slurm_mutex_lock(&feature_index_mutex);
+	if (index->hash && (index->list == feature_list) &&
+	    (index->del_cnt == feature_del_cnt) &&
+	    (index->rec_cnt + 1 == list_count(feature_list))) {
+		_feature_index_add(feature_ptr, index->hash);
+		index->rec_cnt++;
+	}
+	slurm_mutex_unlock(&feature_index_mutex);
+}
+
+extern node_feature_t *find_feature_record(List feature_list, char *name)
+{
+	feature_index_t *index = _feature_index(feature_list);
+	node_feature_t *feature_ptr;
+
+	if (!index || !name)
+		return list_find_first(feature_list, list_find_feature, name);
+
+	slurm_mutex_lock(&feature_index_mutex);
+	_feature_index_sync(index, feature_list);
+	feature_ptr = xhash_get_str(index->hash, name);
+	slurm_mutex_unlock(&feature_index_mutex);
+
+	return feature_ptr;
+}
+
 /* _list_delete_feature - delete an entry from the feature list,
  *	see list.h for documentation */
 static void _list_delete_feature(void *feature_entry)
@@ -1887,6 +1972,9 @@ static void _list_delete_feature(void *feature_entry)
 
 	xassert(feature_ptr);
 	xassert(feature_ptr->magic == FEATURE_MAGIC);
+	slurm_mutex_lock(&feature_index_mutex);
+	feature_del_cnt++;
+	slurm_mutex_unlock(&feature_index_mutex);
 	xfree (feature_ptr->name);
 	FREE_NULL_BITMAP (feature_ptr->node_bitmap);
 	xfree (feature_ptr);
@@ -1933,6 +2021,8 @@ extern void build_feature_list_eq(void)
 		active_feature_ptr->node_bitmap =
 			bit_copy(avail_feature_ptr->node_bitmap);
 		list_append(active_feature_list, active_feature_ptr);
+		_feature_index_append(active_feature_list,
+				      active_feature_ptr);
 	}
 	list_iterator_destroy(feature_iter);
 }
@@ -148,6 +148,26 @@ typedef struct {
 	bitstr_t *node_bitmap;
 } resv_select_t;
 
+/*
+ * Index of resv_list ordered by start time so job_test_resv() only visits
+ * the reservations which can overlap a job's time window rather than every
+ * reservation for every pending job. Floating reservations move with the
+ * current time, so they are kept apart and always visited.
+ */
+typedef struct {
+	time_t end_time;
+	int pos;		/* position in resv_list, to keep its order */
+	slurmctld_resv_t *resv_ptr;
+	time_t start_time;
+} resv_time_idx_t;
+
+static resv_time_idx_t *resv_time_idx = NULL;
+static int resv_time_idx_cnt = 0;	/* fixed time reservations */
+static int resv_time_idx_float_cnt = 0;	/* appended after fixed ones */
+static time_t resv_time_idx_expire = 0;	/* first end_time in the index */
+static uint32_t resv_time_idx_max_boot = 0;
+static bool resv_time_idx_valid = false;
+
 /*
  * the associated functions are the following
  */
@@ -215,6 +235,7 @@ static bool _resv_overlap(resv_desc_msg_t *resv_desc_ptr,
 			  slurmctld_resv_t *this_resv_ptr);
 static bool _resv_time_overlap(resv_desc_msg_t *resv_desc_ptr,
 			       slurmctld_resv_t *resv_ptr);
+static void _resv_time_idx_invalidate(void);
 static void _run_script(char *script, slurmctld_resv_t *resv_ptr, char *name);
 static int  _select_nodes(resv_desc_msg_t *resv_desc_ptr,
 			  part_record_t **part_ptr,
@@ -628,6 +649,7 @@ static void _del_resv_rec(void *x)
 	slurmctld_resv_t *resv_ptr = (slurmctld_resv_t *) x;
 
 	if (resv_ptr) {
+		_resv_time_idx_invalidate();
 		/*
 		 * If shutting down magnetic_resv_list is already freed, meaning
 		 * we don't need to remove anything from it.
@@ -676,6 +698,7 @@ static void _create_resv_lists(bool flush)
 	if (flush && resv_list) {
 		list_flush(magnetic_resv_list);
 		list_flush(resv_list);
+		_resv_time_idx_invalidate();
 		return;
 	}
 
@@ -693,6 +716,7 @@ static void _add_resv_to_lists(slurmctld_resv_t *resv_ptr)
 	list_append(resv_list, resv_ptr);
 	if (resv_ptr->flags & RESERVE_FLAG_MAGNETIC)
 		list_append(magnetic_resv_list, resv_ptr);
+	_resv_time_idx_invalidate();
 }
 
 static int _queue_magnetic_resv(void *x, void *key)
@@ -3301,6 +3325,9 @@ extern void resv_fini(void)
 {
 	FREE_NULL_LIST(magnetic_resv_list);
 	FREE_NULL_LIST(resv_list);
+	xfree(resv_time_idx);
+	resv_time_idx_cnt = resv_time_idx_float_cnt = 0;
+	_resv_time_idx_invalidate();
 }
 
 static int _validate_reservation_access_update(void *x, void *y)
@@ -3751,6 +3778,8 @@ extern int update_resv(resv_desc_msg_t *resv_desc_ptr, char **err_msg)
 		if (resv_ptr->end_time < now)
 			resv_ptr->end_time = now;
 	}
+	/* The time index is ordered by start time and holds end times */
+	_resv_time_idx_invalidate();
 
 	if (resv_ptr->start_time >= resv_ptr->end_time) {
 		info("Reservation %s request has invalid times (start > end)",
@@ -6804,6 +6833,135 @@ static void _print_constraint_planning(constraint_planning_t* sched)
 	list_iterator_destroy(iter);
 }
 
+static void _resv_time_idx_invalidate(void)
+{
+	resv_time_idx_valid = false;
+}
+
+static int _resv_time_idx_sort(const void *x, const void *y)
+{
+	const resv_time_idx_t *idx1 = x, *idx2 = y;
+
+	if (idx1->start_time < idx2->start_time)
+		return -1;
+	if (idx1->start_time > idx2->start_time)
+		return 1;
+	return idx1->pos - idx2->pos;
+}
+
+static int _resv_time_idx_sort_pos(const void *x, const void *y)
+{
+	const resv_time_idx_t *idx1 = x, *idx2 = y;
+
+	return idx1->pos - idx2->pos;
+}
+
+/*
+ * Rebuild resv_time_idx if resv_list changed or one of the indexed
+ * reservations ended, advancing expired recurring reservations first as
+ * _get_rel_start_end() would do.
+ */
+static void _resv_time_idx_build(time_t now)
+{
+	slurmctld_resv_t *resv_ptr;
+	list_itr_t *iter;
+	int fixed_cnt = 0, float_cnt = 0, pos = 0, size;
+
+	if (resv_time_idx_valid && (now < resv_time_idx_expire))
+		return;
+
+	iter = list_iterator_create(resv_list);
+	while ((resv_ptr = list_next(iter))) {
+		if (!(resv_ptr->flags & RESERVE_FLAG_TIME_FLOAT) &&
+		    (resv_ptr->end_time <= now))
+			(void) _advance_resv_time(resv_ptr);
+	}
+	list_iterator_reset(iter);
+
+	size = list_count(resv_list);
+	xrecalloc(resv_time_idx, size, sizeof(*resv_time_idx));
+	resv_time_idx_expire = (time_t) INFINITE;
+	resv_time_idx_max_boot = 0;
+	while ((resv_ptr = list_next(iter))) {
+		resv_time_idx_t *idx;
+
+		pos++;
+		if (resv_ptr->flags & RESERVE_FLAG_TIME_FLOAT) {
+			idx = &resv_time_idx[size - ++float_cnt];
+		} else {
+			idx = &resv_time_idx[fixed_cnt++];
+			/* Ended ones are left for job_resv_check() to purge */
+			if (resv_ptr->end_time > now)
+				resv_time_idx_expire =
+					MIN(resv_time_idx_expire,
+					    resv_ptr->end_time);
+		}
+		idx->end_time = resv_ptr->end_time;
+		idx->pos = pos;
+		idx->resv_ptr = resv_ptr;
+		idx->start_time = resv_ptr->start_time_first;
+		resv_time_idx_max_boot = MAX(resv_time_idx_max_boot,
+					     resv_ptr->boot_time);
+	}
+	list_iterator_destroy(iter);
+
+	/* Floating reservations were filled in from the end of the array */
+	qsort(resv_time_idx, fixed_cnt, sizeof(*resv_time_idx),
+	      _resv_time_idx_sort);
+
+	resv_time_idx_cnt = fixed_cnt;
+	resv_time_idx_float_cnt = float_cnt;
+	resv_time_idx_valid = true;
+}
+
+/*
+ * Find the reservations which may overlap a job running from start_time to
+ * end_time (plus node boot time if reboot). The caller still checks each
+ * reservation's time with _get_rel_start_end(), so this only has to avoid
+ * missing any of them.
+ * RET count of reservations in cand_ptr (xfree), in resv_list order
+ */
+static int _resv_time_idx_find(time_t now, time_t start_time, time_t end_time,
+			       bool reboot, slurmctld_resv_t ***cand_ptr)
+{
+	resv_time_idx_t *cand;
+	slurmctld_resv_t **resv_array;
+	int cnt = 0, lo = 0, hi, mid;
+
+	_resv_time_idx_build(now);
+
+	if (reboot)
+		end_time += resv_time_idx_max_boot;
+
+	/* Fixed reservations starting before the job ends */
+	hi = resv_time_idx_cnt;
+	while (lo < hi) {
+		mid = (lo + hi) / 2;
+		if (resv_time_idx[mid].start_time < end_time)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	cand = xcalloc(lo + resv_time_idx_float_cnt + 1, sizeof(*cand));
+	for (int i = 0; i < lo; i++) {
+		if (resv_time_idx[i].end_time > start_time)
+			cand[cnt++] = resv_time_idx[i];
+	}
+	memcpy(&cand[cnt], &resv_time_idx[resv_time_idx_cnt],
+	       resv_time_idx_float_cnt * sizeof(*cand));
+	cnt += resv_time_idx_float_cnt;
+	qsort(cand, cnt, sizeof(*cand), _resv_time_idx_sort_pos);
+
+	resv_array = xcalloc(cnt + 1, sizeof(*resv_array));
+	for (int i = 0; i < cnt; i++)
+		resv_array[i] = cand[i].resv_ptr;
+	xfree(cand);
+
+	*cand_ptr = resv_array;
+	return cnt;
+}
+
 static void _get_rel_start_end(slurmctld_resv_t *resv_ptr, time_t now,
 			       time_t *start_relative, time_t *end_relative)
 {
@@ -6906,8 +7064,8 @@ extern int job_test_resv(job_record_t *job_ptr, time_t *when,
 	time_t job_start_time, job_end_time, job_end_time_use, lic_resv_time;
 	time_t start_relative, end_relative;
 	time_t now = time(NULL);
-	list_itr_t *iter;
-	int i, rc = SLURM_SUCCESS, rc2;
+	slurmctld_resv_t **cand = NULL;
+	int cand_cnt, i, rc = SLURM_SUCCESS, rc2;
 
 	*resv_overlap = false;	/* initialize to false */
 	job_start_time = *when;
@@ -6989,8 +7147,10 @@ extern int job_test_resv(job_record_t *job_ptr, time_t *when,
 		 * if there are any overlapping reservations, we need to
 		 * prevent the job from using those nodes (e.g. MAINT nodes)
 		 */
-		iter = list_iterator_create(resv_list);
-		while ((res2_ptr = list_next(iter))) {
+		cand_cnt = _resv_time_idx_find(now, job_start_time,
+					       job_end_time, reboot, &cand);
+		for (int j = 0; j < cand_cnt; j++) {
+			res2_ptr = cand[j];
 			if (reboot)
 				job_end_time_use =
 					job_end_time + res2_ptr->boot_time;
@@ -7020,7 +7180,7 @@ extern int job_test_resv(job_record_t *job_ptr, time_t *when,
 				bit_and_not(*node_bitmap,res2_ptr->node_bitmap);
 			}
 		}
-		list_iterator_destroy(iter);
+		xfree(cand);
 
 		if (slurm_conf.debug_flags & DEBUG_FLAG_RESERVATION) {
 			char *nodes = bitmap2node_name(*node_bitmap);
@@ -7064,8 +7224,10 @@ extern int job_test_resv(job_record_t *job_ptr, time_t *when,
 	for (i = 0; ; i++) {
 		lic_resv_time = (time_t) 0;
 
-		iter = list_iterator_create(resv_list);
-		while ((resv_ptr = list_next(iter))) {
+		cand_cnt = _resv_time_idx_find(now, job_start_time,
+					       job_end_time, reboot, &cand);
+		for (int j = 0; j < cand_cnt; j++) {
+			resv_ptr = cand[j];
 			_get_rel_start_end(
 				resv_ptr, now, &start_relative, &end_relative);
 
@@ -7160,7 +7322,7 @@ extern int job_test_resv(job_record_t *job_ptr, time_t *when,
 				continue;
 			}
 		}
-		list_iterator_destroy(iter);
+		xfree(cand);
 
 		if (resv_exc_ptr) {
 			free_core_array(&resv_exc_ptr->exc_cores);
@@ -7442,6 +7604,7 @@ static int _advance_resv_time(slurmctld_resv_t *resv_ptr)
 		resv_ptr->ctld_flags &= (~RESV_CTLD_PROLOG);
 		resv_ptr->ctld_flags &= (~RESV_CTLD_EPILOG);
 		_post_resv_create(resv_ptr);
+		_resv_time_idx_invalidate();
 		last_resv_update = time(NULL);
 		schedule_resv_save();
 		rc = SLURM_SUCCESS;
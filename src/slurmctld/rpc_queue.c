@@ -37,6 +37,7 @@
 #include "config.h"
 
 #include <inttypes.h>
+#include <sched.h>
 
 #if HAVE_SYS_PRCTL_H
 #include <sys/prctl.h>
@@ -46,6 +47,7 @@
 #include "src/common/macros.h"
 #include "src/common/read_config.h"
 #include "src/common/slurm_protocol_defs.h"
+#include "src/common/timers.h"
 #include "src/common/xmalloc.h"
 #include "src/common/xstring.h"
 
@@ -54,13 +56,21 @@
 #include "src/slurmctld/proc_req.h"
 #include "src/slurmctld/state_save.h"
 
+/*
+ * Limit how long one queue may hold the slurmctld locks while draining a
+ * burst, so other RPCs and the scheduler are not starved behind it.
+ */
+#define RPC_QUEUE_MAX_PER_CYCLE	256		/* messages per lock hold */
+#define RPC_QUEUE_MAX_HOLD_USEC	100000		/* usec per lock hold */
+
 bool enabled = true;
 
 static void *_rpc_queue_worker(void *arg)
 {
 	slurmctld_rpc_t *q = (slurmctld_rpc_t *) arg;
 	slurm_msg_t *msg;
-	int processed = 0;
+	int processed = 0, cycle_cnt = 0;
+	struct timeval hold_start = { 0, 0 };
 
 #if HAVE_SYS_PRCTL_H
 	char *name = xstrdup_printf("rpcq-%u", q->msg_type);
@@ -75,6 +85,7 @@ static void *_rpc_queue_worker(void *arg)
 	 * On rpc_queue_init() this will proceed directly to slurm_cond_wait().
 	 */
 	lock_slurmctld(q->locks);
+	(void) slurm_delta_tv(&hold_start);
 
 	/*
 	 * Process as many queued messages as possible in one slurmctld_lock()
@@ -128,6 +139,9 @@ static void *_rpc_queue_worker(void *arg)
 			log_flag(PROTOCOL, "%s(%s): woke up",
 				 __func__, q->msg_name);
 			lock_slurmctld(q->locks);
+			cycle_cnt = 0;
+			hold_start.tv_sec = 0;
+			(void) slurm_delta_tv(&hold_start);
 		} else {
 			DEF_TIMERS;
 			START_TIMER;
@@ -141,6 +155,27 @@ static void *_rpc_queue_worker(void *arg)
 			record_rpc_stats(msg, DELTA_TIMER);
 			slurm_free_msg(msg);
 			processed++;
+			cycle_cnt++;
+
+			/*
+			 * Briefly release the locks if this burst has held
+			 * them too long and more work is still queued.
+			 */
+			if (((cycle_cnt >= RPC_QUEUE_MAX_PER_CYCLE) ||
+			     (slurm_delta_tv(&hold_start) >=
+			      RPC_QUEUE_MAX_HOLD_USEC)) &&
+			    list_count(q->work)) {
+				unlock_slurmctld(q->locks);
+				if (q->post_func)
+					q->post_func();
+				log_flag(PROTOCOL, "%s(%s): yielding locks after processing %d",
+					 __func__, q->msg_name, cycle_cnt);
+				sched_yield();
+				lock_slurmctld(q->locks);
+				cycle_cnt = 0;
+				hold_start.tv_sec = 0;
+				(void) slurm_delta_tv(&hold_start);
+			}
 		}
 	}
 
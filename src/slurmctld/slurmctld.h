@@ -1373,6 +1373,15 @@ extern List feature_list_copy(List feature_list_src);
 extern job_record_t *find_job_array_rec(uint32_t array_job_id,
 					uint32_t array_task_id);
 
+/*
+ * find_feature_record - find a feature by name in a feature list, looked up
+ *	through a name index for active_feature_list and avail_feature_list
+ * IN feature_list - list of node_feature_t to search
+ * IN name - name of the desired feature
+ * RET pointer to the feature record or NULL if not found
+ */
+extern node_feature_t *find_feature_record(list_t *feature_list, char *name);
+
 /*
  * find_het_job_record - return a pointer to the job record with the given ID
  * IN job_id - requested job's ID
@@ -1136,9 +1136,8 @@ static bitstr_t *_pick_step_nodes(job_record_t *job_ptr,
 		 * FIXME: Add support for AND, OR, etc. here if desired
 		 */
 		node_feature_t *feat_ptr;
-		feat_ptr = list_find_first(active_feature_list,
-					   list_find_feature,
-					   (void *) step_spec->features);
+		feat_ptr = find_feature_record(active_feature_list,
+					       step_spec->features);
 		if (feat_ptr && feat_ptr->node_bitmap)
 			bit_and(nodes_avail, feat_ptr->node_bitmap);
 		else
@@ -1902,21 +1901,19 @@ static int _gres_filter_avail_cores(void *x, void *arg)
 	return 0;
 }
 
-/* Return true if a core was picked, false if not */
+/*
+ * Return true if a core was picked, false if not
+ * IN core_start_bit - offset of the node's first core in the job's core
+ *		       bitmaps, see get_job_resources_offset()
+ */
 static bool _pick_step_core(step_record_t *step_ptr,
 			    job_resources_t *job_resrcs_ptr,
 			    bitstr_t *avail_core_bitmap, int job_node_inx,
+			    int core_start_bit, uint16_t cores,
 			    int sock_inx, int core_inx, bool use_all_cores,
 			    bool oversubscribing_cores)
 {
-	int bit_offset;
-
-	bit_offset = get_job_resources_offset(job_resrcs_ptr,
-					      job_node_inx,
-					      sock_inx,
-					      core_inx);
-	if (bit_offset < 0)
-		fatal("get_job_resources_offset");
+	int bit_offset = core_start_bit + (sock_inx * cores) + core_inx;
 
 	if (!bit_test(avail_core_bitmap, bit_offset))
 		return false;
@@ -1950,7 +1947,8 @@ static bool _pick_step_core(step_record_t *step_ptr,
 static bool _handle_core_select(step_record_t *step_ptr,
 				job_resources_t *job_resrcs_ptr,
 				bitstr_t *avail_core_bitmap,
-				int job_node_inx, uint16_t sockets,
+				int job_node_inx, int core_start_bit,
+				uint16_t sockets,
 				uint16_t cores, bool use_all_cores,
 				bool oversubscribing_cores, int *core_cnt,
 				uint16_t cores_per_task)
@@ -1987,8 +1985,10 @@ static bool _handle_core_select(step_record_t *step_ptr,
 
 				if (!_pick_step_core(step_ptr, job_resrcs_ptr,
 						     avail_core_bitmap,
-						     job_node_inx, sock_inx,
-						     core_inx, use_all_cores,
+						     job_node_inx,
+						     core_start_bit, cores,
+						     sock_inx, core_inx,
+						     use_all_cores,
 						     oversubscribing_cores))
 					continue;
 
@@ -2007,8 +2007,10 @@ static bool _handle_core_select(step_record_t *step_ptr,
 			for (sock_inx = 0; sock_inx < sockets; sock_inx++) {
 				if (!_pick_step_core(step_ptr, job_resrcs_ptr,
 						     avail_core_bitmap,
-						     job_node_inx, sock_inx,
-						     core_inx, use_all_cores,
+						     job_node_inx,
+						     core_start_bit, cores,
+						     sock_inx, core_inx,
+						     use_all_cores,
 						     oversubscribing_cores)) {
 						if (sock_inx == sockets)
 							sock_inx = 0;
@@ -2039,6 +2041,8 @@ static bool _handle_core_select(step_record_t *step_ptr,
 						job_resrcs_ptr,
 						avail_core_bitmap,
 						job_node_inx,
+						core_start_bit,
+						cores,
 						sock_inx,
 						core_inx,
 						use_all_cores,
@@ -2072,7 +2076,7 @@ static int _pick_step_cores(step_record_t *step_ptr,
 			    int gres_cpus_alloc)
 {
 	uint16_t sockets, cores, cores_per_task, tasks_per_node;
-	int core_cnt = (int) task_cnt;
+	int core_cnt = (int) task_cnt, core_start_bit, rc = SLURM_SUCCESS;
 	bool use_all_cores;
 	bitstr_t *all_gres_core_bitmap = NULL, *any_gres_core_bitmap = NULL;
 
@@ -2085,6 +2089,9 @@ static int _pick_step_cores(step_record_t *step_ptr,
 	if (get_job_resources_cnt(job_resrcs_ptr, job_node_inx,
 				  &sockets, &cores))
 		fatal("get_job_resources_cnt");
+	if ((core_start_bit = get_job_resources_offset(job_resrcs_ptr,
+						       job_node_inx, 0, 0)) < 0)
+		fatal("get_job_resources_offset");
 
 	if (ntasks_per_core != INFINITE16)
 		tasks_per_node = cores * ntasks_per_core * sockets;
@@ -2119,14 +2126,9 @@ static int _pick_step_cores(step_record_t *step_ptr,
 		}
 	}
 
-	all_gres_core_bitmap = bit_copy(job_resrcs_ptr->core_bitmap);
-	any_gres_core_bitmap = bit_copy(job_resrcs_ptr->core_bitmap);
 	if (step_ptr->gres_list_alloc) {
 		foreach_gres_filter_t args = {
-			.all_gres_core_bitmap = all_gres_core_bitmap,
-			.any_gres_core_bitmap = any_gres_core_bitmap,
-			.core_start_bit = get_job_resources_offset(
-				job_resrcs_ptr, job_node_inx, 0, 0),
+			.core_start_bit = core_start_bit,
 			.core_end_bit = get_job_resources_offset(
 				job_resrcs_ptr, job_node_inx, sockets - 1,
 				cores - 1),
@@ -2135,6 +2137,11 @@ static int _pick_step_cores(step_record_t *step_ptr,
 				node_record_table_ptr[node_inx]->gres_list,
 		};
 
+		all_gres_core_bitmap = bit_copy(job_resrcs_ptr->core_bitmap);
+		any_gres_core_bitmap = bit_copy(job_resrcs_ptr->core_bitmap);
+		args.all_gres_core_bitmap = all_gres_core_bitmap;
+		args.any_gres_core_bitmap = any_gres_core_bitmap;
+
 		if ((args.core_start_bit > bit_size(all_gres_core_bitmap)) ||
 		    (args.core_end_bit > bit_size(all_gres_core_bitmap)))
 			error("coremap offsets fall outside core_bitmap size. This should never happen.");
@@ -2148,32 +2155,43 @@ static int _pick_step_cores(step_record_t *step_ptr,
 			bit_and(any_gres_core_bitmap,
 				job_resrcs_ptr->core_bitmap);
 		}
+	} else {
+		/*
+		 * Without GRES there is nothing to filter, so avoid copying
+		 * the job's core_bitmap for every node of the step. The
+		 * passes below only read these bitmaps and compare them.
+		 */
+		all_gres_core_bitmap = job_resrcs_ptr->core_bitmap;
+		any_gres_core_bitmap = job_resrcs_ptr->core_bitmap;
 	}
 	cores_per_task = ROUNDUP(core_cnt, task_cnt); /* Round up */
 
 	/* select idle cores that fit all gres binding first */
 	if (_handle_core_select(step_ptr, job_resrcs_ptr,
 				all_gres_core_bitmap, job_node_inx,
-				sockets, cores, use_all_cores, false, &core_cnt,
-				cores_per_task))
+				core_start_bit, sockets, cores, use_all_cores,
+				false, &core_cnt, cores_per_task))
 		goto cleanup;
 
 	/* select idle cores that fit any gres binding second */
-	if (!bit_equal(all_gres_core_bitmap, any_gres_core_bitmap) &&
+	if ((all_gres_core_bitmap != any_gres_core_bitmap) &&
+	    !bit_equal(all_gres_core_bitmap, any_gres_core_bitmap) &&
 	    _handle_core_select(step_ptr, job_resrcs_ptr,
 				any_gres_core_bitmap, job_node_inx,
-				sockets, cores, use_all_cores, false, &core_cnt,
-				cores_per_task))
+				core_start_bit, sockets, cores, use_all_cores,
+				false, &core_cnt, cores_per_task))
 		goto cleanup;
 
 	/* select any idle cores */
 	if (!(step_ptr->job_ptr->bit_flags & GRES_ENFORCE_BIND) &&
+	    (any_gres_core_bitmap != job_resrcs_ptr->core_bitmap) &&
 	    !bit_equal(any_gres_core_bitmap, job_resrcs_ptr->core_bitmap)) {
 		log_flag(STEPS, "gres topology sub-optimal for %ps",
 			&(step_ptr->step_id));
 		if (_handle_core_select(step_ptr, job_resrcs_ptr,
 					job_resrcs_ptr->core_bitmap,
-					job_node_inx, sockets, cores,
+					job_node_inx, core_start_bit,
+					sockets, cores,
 					use_all_cores, false, &core_cnt,
 					cores_per_task))
 			goto cleanup;
@@ -2186,9 +2204,8 @@ static int _pick_step_cores(step_record_t *step_ptr,
 
 
 	if (!(step_ptr->flags & SSF_OVERCOMMIT)) {
-		FREE_NULL_BITMAP(all_gres_core_bitmap);
-		FREE_NULL_BITMAP(any_gres_core_bitmap);
-		return ESLURM_NODES_BUSY;
+		rc = ESLURM_NODES_BUSY;
+		goto cleanup;
 	}
 
 	/* We need to over-subscribe one or more cores. */
@@ -2202,32 +2219,36 @@ static int _pick_step_cores(step_record_t *step_ptr,
 	/* oversubscribe cores that fit all gres binding first */
 	if (_handle_core_select(step_ptr, job_resrcs_ptr,
 				all_gres_core_bitmap, job_node_inx,
-				sockets, cores, use_all_cores, true, &core_cnt,
-				cores_per_task))
+				core_start_bit, sockets, cores, use_all_cores,
+				true, &core_cnt, cores_per_task))
 		goto cleanup;
 
 	/* oversubscribe cores that fit any gres binding second */
-	if (!bit_equal(all_gres_core_bitmap, any_gres_core_bitmap) &&
+	if ((all_gres_core_bitmap != any_gres_core_bitmap) &&
+	    !bit_equal(all_gres_core_bitmap, any_gres_core_bitmap) &&
 	    _handle_core_select(step_ptr, job_resrcs_ptr,
 				any_gres_core_bitmap, job_node_inx,
-				sockets, cores, use_all_cores, true, &core_cnt,
-				cores_per_task))
+				core_start_bit, sockets, cores, use_all_cores,
+				true, &core_cnt, cores_per_task))
 		goto cleanup;
 
 	/* oversubscribe any cores */
 	if (!(step_ptr->job_ptr->bit_flags & GRES_ENFORCE_BIND) &&
+	    (any_gres_core_bitmap != job_resrcs_ptr->core_bitmap) &&
 	    !bit_equal(any_gres_core_bitmap, job_resrcs_ptr->core_bitmap) &&
 	    _handle_core_select(step_ptr, job_resrcs_ptr,
 				job_resrcs_ptr->core_bitmap, job_node_inx,
-				sockets, cores, use_all_cores, true, &core_cnt,
-				cores_per_task))
+				core_start_bit, sockets, cores, use_all_cores,
+				true, &core_cnt, cores_per_task))
 		goto cleanup;
 
 
 cleanup:
-	FREE_NULL_BITMAP(all_gres_core_bitmap);
-	FREE_NULL_BITMAP(any_gres_core_bitmap);
-	return SLURM_SUCCESS;
+	if (step_ptr->gres_list_alloc) {
+		FREE_NULL_BITMAP(all_gres_core_bitmap);
+		FREE_NULL_BITMAP(any_gres_core_bitmap);
+	}
+	return rc;
 }
 
 static bool _use_one_thread_per_core(step_record_t *step_ptr)
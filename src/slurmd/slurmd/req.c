@@ -44,6 +44,7 @@
 #define _GNU_SOURCE	/* for setresuid() */
 
 #include <ctype.h>
+#include <dirent.h>
 #include <fcntl.h>
 #include <ftw.h>
 #include <grp.h>
@@ -57,6 +58,7 @@
 #include <signal.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
 #include <sys/param.h>
 #include <sys/stat.h>
 #include <sys/types.h>
@@ -273,7 +275,11 @@ static pthread_mutex_t prolog_mutex = PTHREAD_MUTEX_INITIALIZER;
 static pthread_mutex_t prolog_serial_mutex = PTHREAD_MUTEX_INITIALIZER;
 
 #define FILE_BCAST_TIMEOUT 300
+#define FILE_BCAST_CACHE_DIR "sbcast_cache"
+#define FILE_BCAST_CACHE_TIMEOUT 86400	/* remove unused cache entries */
+#define FILE_BCAST_CACHE_SCAN 3600	/* interval to look for them */
 static pthread_rwlock_t file_bcast_lock = PTHREAD_RWLOCK_INITIALIZER;
+static pthread_mutex_t file_bcast_cache_mutex = PTHREAD_MUTEX_INITIALIZER;
 static list_t *file_bcast_list = NULL;
 static list_t *bcast_libdir_list = NULL;
 
@@ -4037,6 +4043,14 @@ static void _free_file_bcast_info_t(void *arg)
 	xfree(f->fname);
 	if (f->fd)
 		close(f->fd);
+	if (f->cache_tmp) {
+		if (f->cache_fd >= 0)
+			close(f->cache_fd);
+		(void) unlink(f->cache_tmp);
+		xfree(f->cache_tmp);
+	}
+	xfree(f->cache_path);
+	xfree(f->file_hash);
 	xfree(f);
 }
 
@@ -4080,15 +4094,381 @@ static int _libdir_find_in_list_to_remove(void *x, void *y)
 	return false;
 }
 
+typedef struct {
+	char *path;
+	off_t size;
+	time_t mtime;
+} file_bcast_cache_ent_t;
+
+static void _free_file_bcast_cache_ent(void *x)
+{
+	file_bcast_cache_ent_t *ent = x;
+
+	xfree(ent->path);
+	xfree(ent);
+}
+
+static int _sort_file_bcast_cache_ent(void *x, void *y)
+{
+	file_bcast_cache_ent_t *ent1 = *(file_bcast_cache_ent_t **) x;
+	file_bcast_cache_ent_t *ent2 = *(file_bcast_cache_ent_t **) y;
+
+	if (ent1->mtime < ent2->mtime)
+		return -1;
+	if (ent1->mtime > ent2->mtime)
+		return 1;
+	return 0;
+}
+
+/*
+ * Remove cache entries which have not been used for a while, then the least
+ * recently used ones until the cache fits in BcastParameters=CacheSize=.
+ * Entries still being written (named <entry>.XXXXXX) belong to a transfer and
+ * are only removed once left over for as long as an unused entry.
+ */
+static void _file_bcast_cache_shrink(time_t now, uint64_t cache_size)
+{
+	char *dir_name;
+	struct dirent *ent;
+	struct stat st;
+	uint64_t total = 0;
+	list_t *entries;
+	file_bcast_cache_ent_t *cache_ent;
+	DIR *dir;
+
+	dir_name = xstrdup_printf("%s/%s", conf->spooldir,
+				  FILE_BCAST_CACHE_DIR);
+	slurm_mutex_lock(&file_bcast_cache_mutex);
+	if (!(dir = opendir(dir_name))) {
+		slurm_mutex_unlock(&file_bcast_cache_mutex);
+		xfree(dir_name);
+		return;
+	}
+	entries = list_create(_free_file_bcast_cache_ent);
+	while ((ent = readdir(dir))) {
+		char *path;
+		bool tmp;
+
+		if (ent->d_name[0] == '.')
+			continue;
+		tmp = (strchr(ent->d_name, '.') != NULL);
+		path = xstrdup_printf("%s/%s", dir_name, ent->d_name);
+		if (stat(path, &st)) {
+			xfree(path);
+		} else if ((!cache_size && !tmp) ||
+			   ((st.st_mtime + FILE_BCAST_CACHE_TIMEOUT) < now)) {
+			debug("Removing unused file_bcast cache entry `%s`",
+			      path);
+			(void) unlink(path);
+			xfree(path);
+		} else if (tmp) {
+			xfree(path);
+		} else {
+			cache_ent = xmalloc(sizeof(*cache_ent));
+			cache_ent->path = path;
+			cache_ent->size = st.st_size;
+			cache_ent->mtime = st.st_mtime;
+			list_append(entries, cache_ent);
+			total += st.st_size;
+		}
+	}
+	closedir(dir);
+
+	if (total > cache_size) {
+		list_sort(entries, _sort_file_bcast_cache_ent);
+		while ((total > cache_size) &&
+		       (cache_ent = list_pop(entries))) {
+			debug("Removing file_bcast cache entry `%s` to stay within CacheSize",
+			      cache_ent->path);
+			(void) unlink(cache_ent->path);
+			total -= cache_ent->size;
+			_free_file_bcast_cache_ent(cache_ent);
+		}
+	}
+	slurm_mutex_unlock(&file_bcast_cache_mutex);
+
+	FREE_NULL_LIST(entries);
+	xfree(dir_name);
+}
+
 /* remove transfers that have stalled */
 static void _file_bcast_cleanup(void)
 {
+	static time_t last_cache_scan = 0;
 	time_t now = time(NULL);
 
 	slurm_rwlock_wrlock(&file_bcast_lock);
 	list_delete_all(file_bcast_list, _bcast_find_in_list_to_remove, &now);
 	list_delete_all(bcast_libdir_list, _libdir_find_in_list_to_remove, &now);
 	slurm_rwlock_unlock(&file_bcast_lock);
+
+	if (difftime(now, last_cache_scan) >= FILE_BCAST_CACHE_SCAN) {
+		last_cache_scan = now;
+		_file_bcast_cache_shrink(now, bcast_cache_size());
+	}
+}
+
+/*
+ * Cache entries are kept per user so one user can never be handed content
+ * another user claimed to have the same hash.
+ * RET path of the cache entry or NULL if file_hash is not a valid hash
+ */
+static char *_file_bcast_cache_path(uid_t uid, char *file_hash)
+{
+	if ((strlen(file_hash) != 64) ||
+	    (strspn(file_hash, "0123456789abcdef") != 64))
+		return NULL;
+
+	return xstrdup_printf("%s/%s/%u_%s", conf->spooldir,
+			      FILE_BCAST_CACHE_DIR, uid, file_hash);
+}
+
+/* Set attributes of a completely received file */
+static void _file_bcast_finish(int fd, file_bcast_msg_t *req,
+			       file_bcast_info_t *key)
+{
+	if (fchmod(fd, (req->modes & 0777))) {
+		error("sbcast: uid:%u can't chmod `%s`: %m",
+		      key->uid, key->fname);
+	}
+	if (fchown(fd, key->uid, key->gid)) {
+		error("sbcast: uid:%u gid:%u can't chown `%s`: %m",
+		      key->uid, key->gid, key->fname);
+	}
+	if (req->atime) {
+		struct timespec time_buf[2];
+		time_buf[0].tv_sec = req->atime;
+		time_buf[0].tv_nsec = 0;
+		time_buf[1].tv_sec = req->mtime;
+		time_buf[1].tv_nsec = 0;
+		if (futimens(fd, time_buf)) {
+			error("sbcast: uid:%u can't futimens `%s`: %m",
+			      key->uid, key->fname);
+		}
+	}
+}
+
+/*
+ * Fill the destination file from a cache entry, with no lock held.
+ * RET SLURM_SUCCESS or SLURM_ERROR, in which case the destination is left
+ *     empty
+ */
+static int _file_bcast_cache_install(int cache_fd, int fd,
+				     file_bcast_msg_t *req,
+				     file_bcast_info_t *key)
+{
+	char buf[64 * 1024];
+	ssize_t in, out, offset;
+	int rc = SLURM_SUCCESS;
+
+	while ((in = read(cache_fd, buf, sizeof(buf)))) {
+		if (in < 0) {
+			if (errno == EINTR)
+				continue;
+			rc = SLURM_ERROR;
+			break;
+		}
+		for (offset = 0; offset < in; offset += out) {
+			out = write(fd, &buf[offset], (in - offset));
+			if (out < 0) {
+				if ((errno == EINTR) || (errno == EAGAIN)) {
+					out = 0;
+					continue;
+				}
+				rc = SLURM_ERROR;
+				break;
+			}
+		}
+		if (rc)
+			break;
+	}
+
+	if (rc) {
+		error("sbcast: uid:%u can't copy cached content to `%s`: %m",
+		      key->uid, key->fname);
+		(void) ftruncate(fd, 0);
+	} else {
+		_file_bcast_finish(fd, req, key);
+	}
+	close(cache_fd);
+	close(fd);
+
+	return rc;
+}
+
+/*
+ * Look for the content with the hash the sender provided in the node's cache,
+ * otherwise start a new cache entry that the following blocks are written to
+ * as well.
+ * Called for the first block only, with the write lock held.
+ * OUT cache_fd - open cache entry
+ * OUT fd - duplicate of the destination file descriptor to fill it from
+ * RET true if the cache holds the content
+ */
+static bool _file_bcast_cache_lookup(file_bcast_info_t *file_info,
+				     file_bcast_msg_t *req, int *cache_fd,
+				     int *fd)
+{
+	char *path, *dir_name;
+	struct stat st;
+
+	if (req->file_size > bcast_cache_size())
+		return false;
+	if (!(path = _file_bcast_cache_path(file_info->uid, req->file_hash)))
+		return false;
+
+	if ((*cache_fd = open(path, O_RDONLY | O_CLOEXEC)) >= 0) {
+		if (!fstat(*cache_fd, &st) && (st.st_size == req->file_size) &&
+		    ((*fd = fcntl(file_info->fd, F_DUPFD_CLOEXEC, 0)) >= 0)) {
+			debug("sbcast: uid:%u using cached `%s` for `%s`",
+			      file_info->uid, path, file_info->fname);
+			(void) utime(path, NULL);
+			xfree(path);
+			return true;
+		}
+		close(*cache_fd);
+	}
+
+	dir_name = xstrdup_printf("%s/%s", conf->spooldir,
+				  FILE_BCAST_CACHE_DIR);
+	if (mkdir(dir_name, 0700) && (errno != EEXIST)) {
+		error("sbcast: can't create `%s`: %m", dir_name);
+		xfree(dir_name);
+		xfree(path);
+		return false;
+	}
+	xfree(dir_name);
+
+	file_info->cache_tmp = xstrdup_printf("%s.XXXXXX", path);
+	file_info->cache_fd = mkostemp(file_info->cache_tmp, O_CLOEXEC);
+	if (file_info->cache_fd < 0) {
+		error("sbcast: can't create `%s`: %m", file_info->cache_tmp);
+		xfree(file_info->cache_tmp);
+		xfree(path);
+		return false;
+	}
+	file_info->cache_path = path;
+	file_info->file_hash = xstrdup(req->file_hash);
+
+	return false;
+}
+
+/*
+ * Add a received block to the cache entry being built. Blocks are written
+ * concurrently under the read lock, so a failure is recorded by the caller.
+ * RET SLURM_SUCCESS or SLURM_ERROR
+ */
+static int _file_bcast_cache_write(file_bcast_info_t *file_info,
+				   file_bcast_msg_t *req)
+{
+	int64_t offset = 0, inx;
+
+	while (req->block_len - offset) {
+		inx = pwrite(file_info->cache_fd, &req->block[offset],
+			     (req->block_len - offset),
+			     req->block_offset + offset);
+		if (inx == -1) {
+			if ((errno == EINTR) || (errno == EAGAIN))
+				continue;
+			debug("sbcast: can't write `%s`: %m",
+			      file_info->cache_tmp);
+			return SLURM_ERROR;
+		}
+		offset += inx;
+	}
+
+	return SLURM_SUCCESS;
+}
+
+/* must not have read lock, will get write lock */
+static void _file_bcast_cache_fail(file_bcast_info_t *key)
+{
+	file_bcast_info_t *file_info;
+
+	slurm_rwlock_wrlock(&file_bcast_lock);
+	if ((file_info = _bcast_lookup_file(key)))
+		file_info->cache_failed = true;
+	slurm_rwlock_unlock(&file_bcast_lock);
+}
+
+/*
+ * Publish a completed cache entry once its content is verified to match the
+ * hash given by the sender, then trim the cache to its size limit.
+ * Runs in its own thread, started for the last block once every other block
+ * has been written.
+ */
+static void *_file_bcast_cache_save(void *arg)
+{
+	file_bcast_info_t *cache_info = arg;
+	char *file_hash = NULL;
+	void *data;
+	int fd;
+
+	if ((fd = open(cache_info->cache_tmp, O_RDONLY | O_CLOEXEC)) >= 0) {
+		data = mmap(NULL, cache_info->file_size, PROT_READ, MAP_SHARED,
+			    fd, 0);
+		if (data != MAP_FAILED) {
+			file_hash = bcast_file_hash(data,
+						    cache_info->file_size);
+			munmap(data, cache_info->file_size);
+		}
+		close(fd);
+	}
+
+	if (!xstrcmp(file_hash, cache_info->file_hash) &&
+	    !rename(cache_info->cache_tmp, cache_info->cache_path)) {
+		debug("sbcast: uid:%u cached `%s` as `%s`",
+		      cache_info->uid, cache_info->fname,
+		      cache_info->cache_path);
+		_file_bcast_cache_shrink(time(NULL), bcast_cache_size());
+	} else {
+		(void) unlink(cache_info->cache_tmp);
+	}
+	xfree(file_hash);
+	xfree(cache_info->cache_tmp);
+	_free_file_bcast_info_t(cache_info);
+
+	return NULL;
+}
+
+/*
+ * Hand a completely received cache entry over to a thread verifying and
+ * publishing it, so the last block is acknowledged without waiting for it.
+ * must not have read lock, will get write lock
+ */
+static void _file_bcast_cache_finish(file_bcast_info_t *key)
+{
+	file_bcast_info_t *file_info, *cache_info;
+
+	slurm_rwlock_wrlock(&file_bcast_lock);
+	if (!(file_info = _bcast_lookup_file(key)) || !file_info->cache_tmp) {
+		slurm_rwlock_unlock(&file_bcast_lock);
+		return;
+	}
+
+	close(file_info->cache_fd);
+	file_info->cache_fd = -1;
+	if (file_info->cache_failed || !file_info->file_size) {
+		(void) unlink(file_info->cache_tmp);
+		xfree(file_info->cache_tmp);
+		slurm_rwlock_unlock(&file_bcast_lock);
+		return;
+	}
+
+	cache_info = xmalloc(sizeof(*cache_info));
+	cache_info->cache_fd = -1;
+	cache_info->cache_path = file_info->cache_path;
+	cache_info->cache_tmp = file_info->cache_tmp;
+	cache_info->file_hash = file_info->file_hash;
+	cache_info->file_size = file_info->file_size;
+	cache_info->fname = xstrdup(file_info->fname);
+	cache_info->uid = file_info->uid;
+	file_info->cache_path = NULL;
+	file_info->cache_tmp = NULL;
+	file_info->file_hash = NULL;
+	slurm_rwlock_unlock(&file_bcast_lock);
+
+	slurm_thread_create_detached(_file_bcast_cache_save, cache_info);
 }
 
 static int _bcast_find_by_job(void *x, void *y)
@@ -4146,7 +4526,8 @@ void file_bcast_purge(void)
 
 static void _rpc_file_bcast(slurm_msg_t *msg)
 {
-	int rc = SLURM_SUCCESS;
+	int rc = SLURM_SUCCESS, cache_rc = SLURM_SUCCESS;
+	int cache_fd = -1, fd = -1;
 	int64_t offset, inx;
 	sbcast_cred_arg_t *cred_arg;
 	file_bcast_info_t *file_info;
@@ -4233,6 +4614,29 @@ static void _rpc_file_bcast(slurm_msg_t *msg)
 		}
 	}
 
+	/*
+	 * The cache entry of the file is looked up or created under the write
+	 * lock, the cached content is copied with no lock held.
+	 */
+	if ((req->block_no == 1) && req->file_hash) {
+		bool cached = false;
+
+		slurm_rwlock_wrlock(&file_bcast_lock);
+		if ((file_info = _bcast_lookup_file(&key)))
+			cached = _file_bcast_cache_lookup(file_info, req,
+							  &cache_fd, &fd);
+		slurm_rwlock_unlock(&file_bcast_lock);
+
+		if (cached) {
+			rc = _file_bcast_cache_install(cache_fd, fd, req,
+						       &key);
+			_file_bcast_close_file(&key);
+			if (rc == SLURM_SUCCESS)
+				rc = ESLURMD_FILE_BCAST_CACHED;
+			goto done;
+		}
+	}
+
 	slurm_rwlock_rdlock(&file_bcast_lock);
 	if (!(file_info = _bcast_lookup_file(&key))) {
 		error("No registered file transfer for uid %u file `%s`.",
@@ -4242,6 +4646,7 @@ static void _rpc_file_bcast(slurm_msg_t *msg)
 		goto done;
 	}
 
+
 	/* now decompress file */
 	if (bcast_decompress_data(req) < 0) {
 		error("sbcast: data decompression error for UID %u, file %s",
@@ -4251,10 +4656,16 @@ static void _rpc_file_bcast(slurm_msg_t *msg)
 		goto done;
 	}
 
+	/*
+	 * Write at the block's offset straight from the received buffer.
+	 * pwrite() does not move the shared file position, so blocks of the
+	 * same file received concurrently cannot interleave.
+	 */
 	offset = 0;
 	while (req->block_len - offset) {
-		inx = write(file_info->fd, &req->block[offset],
-			    (req->block_len - offset));
+		inx = pwrite(file_info->fd, &req->block[offset],
+			     (req->block_len - offset),
+			     req->block_offset + offset);
 		if (inx == -1) {
 			if ((errno == EINTR) || (errno == EAGAIN))
 				continue;
@@ -4267,33 +4678,21 @@ static void _rpc_file_bcast(slurm_msg_t *msg)
 		offset += inx;
 	}
 
+	if (file_info->cache_tmp && !file_info->cache_failed)
+		cache_rc = _file_bcast_cache_write(file_info, req);
+
 	file_info->last_update = time(NULL);
 
-	if ((req->flags & FILE_BCAST_LAST_BLOCK) &&
-	    fchmod(file_info->fd, (req->modes & 0777))) {
-		error("sbcast: uid:%u can't chmod `%s`: %m",
-		      key.uid, key.fname);
-	}
-	if ((req->flags & FILE_BCAST_LAST_BLOCK) &&
-	    fchown(file_info->fd, key.uid, key.gid)) {
-		error("sbcast: uid:%u gid:%u can't chown `%s`: %m",
-		      key.uid, key.gid, key.fname);
-	}
-	if ((req->flags & FILE_BCAST_LAST_BLOCK) && req->atime) {
-		struct timespec time_buf[2];
-		time_buf[0].tv_sec = req->atime;
-		time_buf[0].tv_nsec = 0;
-		time_buf[1].tv_sec = req->mtime;
-		time_buf[1].tv_nsec = 0;
-		if (futimens(file_info->fd, time_buf)) {
-			error("sbcast: uid:%u can't futimens `%s`: %m",
-			      key.uid, key.fname);
-		}
-	}
+	if (req->flags & FILE_BCAST_LAST_BLOCK)
+		_file_bcast_finish(file_info->fd, req, &key);
 
 	slurm_rwlock_unlock(&file_bcast_lock);
 
+	if (cache_rc != SLURM_SUCCESS)
+		_file_bcast_cache_fail(&key);
+
 	if (req->flags & FILE_BCAST_LAST_BLOCK) {
+		_file_bcast_cache_finish(&key);
 		_file_bcast_close_file(&key);
 	}
 
@@ -4360,6 +4759,8 @@ static int _file_bcast_register_file(slurm_msg_t *msg,
 
 	file_info = xmalloc(sizeof(file_bcast_info_t));
 	file_info->fd = fd;
+	file_info->cache_fd = -1;
+	file_info->file_size = req->file_size;
 	file_info->fname = xstrdup(req->fname);
 	file_info->uid = key->uid;
 	file_info->gid = key->gid;
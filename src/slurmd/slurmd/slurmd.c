@@ -129,6 +129,8 @@
 decl_static_data(usage_txt);
 
 #define MAX_THREADS		256
+#define MAX_IDLE_WORKERS	32	/* connection workers kept for reuse */
+#define WORKER_IDLE_SECS	60	/* idle time before a worker exits */
 
 #define _free_and_set(__dst, __src)		\
 	do {					\
@@ -154,6 +156,13 @@ static int             active_threads = 0;
 static pthread_mutex_t active_mutex   = PTHREAD_MUTEX_INITIALIZER;
 static pthread_cond_t  active_cond    = PTHREAD_COND_INITIALIZER;
 
+/*
+ * connections waiting for a worker thread, protected by active_mutex
+ */
+static list_t         *conn_list      = NULL;
+static int             idle_workers   = 0;
+static pthread_cond_t  conn_cond      = PTHREAD_COND_INITIALIZER;
+
 typedef struct connection {
 	int fd;
 	slurm_addr_t *cli_addr;
@@ -215,6 +224,7 @@ static void      _resource_spec_fini(void);
 static int       _resource_spec_init(void);
 static void      _select_spec_cores(void);
 static void     *_service_connection(void *);
+static void     *_service_worker(void *);
 static int       _set_slurmd_spooldir(const char *dir);
 static int       _set_topo_info(void);
 static int       _set_work_dir(void);
@@ -518,6 +528,10 @@ static void _msg_engine(void)
 		error("accept: %m");
 	}
 	verbose("got shutdown request");
+	/* Let idle connection workers exit */
+	slurm_mutex_lock(&active_mutex);
+	slurm_cond_broadcast(&conn_cond);
+	slurm_mutex_unlock(&active_mutex);
 	close(conf->lfd);
 	conf->lfd = -1;
 }
@@ -584,12 +598,64 @@ _wait_for_all_threads(int secs)
 static void _handle_connection(int fd, slurm_addr_t *cli)
 {
 	conn_t *arg = xmalloc(sizeof(conn_t));
+	bool spawn = false;
 
 	arg->fd       = fd;
 	arg->cli_addr = cli;
 
 	_increment_thd_count();
-	slurm_thread_create_detached(_service_connection, arg);
+
+	/*
+	 * Hand the connection to an idle worker if there is one, otherwise
+	 * start a new worker. _increment_thd_count() above still bounds the
+	 * number of connections being serviced at once to MAX_THREADS.
+	 */
+	slurm_mutex_lock(&active_mutex);
+	if (!conn_list)
+		conn_list = list_create(NULL);
+	list_enqueue(conn_list, arg);
+	if (list_count(conn_list) > idle_workers)
+		spawn = true;
+	else
+		slurm_cond_signal(&conn_cond);
+	slurm_mutex_unlock(&active_mutex);
+
+	if (spawn)
+		slurm_thread_create_detached(_service_worker, NULL);
+}
+
+/*
+ * Service queued connections, then stay around for up to WORKER_IDLE_SECS
+ * waiting for more so bursts of RPCs do not create a thread per connection.
+ */
+static void *_service_worker(void *arg)
+{
+	conn_t *con;
+	struct timespec ts = { 0, 0 };
+	int rc = 0;
+
+	slurm_mutex_lock(&active_mutex);
+	while (true) {
+		if ((con = list_dequeue(conn_list))) {
+			slurm_mutex_unlock(&active_mutex);
+			_service_connection(con);
+			slurm_mutex_lock(&active_mutex);
+			rc = 0;
+			continue;
+		}
+
+		if (_shutdown || (rc == ETIMEDOUT) ||
+		    (idle_workers >= MAX_IDLE_WORKERS))
+			break;
+
+		idle_workers++;
+		ts.tv_sec = time(NULL) + WORKER_IDLE_SECS;
+		rc = pthread_cond_timedwait(&conn_cond, &active_mutex, &ts);
+		idle_workers--;
+	}
+	slurm_mutex_unlock(&active_mutex);
+
+	return NULL;
 }
 
 static void *
@@ -3158,6 +3158,7 @@ static int _send_mult_msg(slurmdbd_conn_t *slurmdbd_conn, persist_msg_t *msg,
 	list_itr_t *itr = NULL;
 	buf_t *req_buf = NULL, *ret_buf = NULL;
 	int rc = SLURM_SUCCESS;
+	bool register_ctld = false;
 	/* DEF_TIMERS; */
 
 	if (!_validate_slurm_user(slurmdbd_conn)) {
@@ -3172,6 +3173,11 @@ static int _send_mult_msg(slurmdbd_conn_t *slurmdbd_conn, persist_msg_t *msg,
 
 	list_msg.my_list = list_create(slurmdbd_free_buffer);
 	/* START_TIMER; */
+	/*
+	 * Commit once for the whole batch below rather than after every
+	 * sub-message, the messages are still processed in order.
+	 */
+	slurmdbd_conn->in_mult_msg = true;
 	itr = list_iterator_create(get_msg->my_list);
 	while ((req_buf = list_next(itr))) {
 		persist_msg_t sub_msg;
@@ -3184,6 +3190,8 @@ static int _send_mult_msg(slurmdbd_conn_t *slurmdbd_conn, persist_msg_t *msg,
 			size_buf(req_buf), &ret_buf, 0);
 
 		if (rc == SLURM_SUCCESS) {
+			if (sub_msg.msg_type == DBD_REGISTER_CTLD)
+				register_ctld = true;
 			rc = proc_req(slurmdbd_conn, &sub_msg, &ret_buf);
 			slurmdbd_free_msg(&sub_msg);
 		}
@@ -3194,9 +3202,29 @@ static int _send_mult_msg(slurmdbd_conn_t *slurmdbd_conn, persist_msg_t *msg,
 			break;
 	}
 	list_iterator_destroy(itr);
+	slurmdbd_conn->in_mult_msg = false;
 	/* END_TIMER; */
 	/* info("%d multi took %s", list_count(get_msg->my_list), TIME_STR); */
 
+	/*
+	 * The replies tell slurmctld to drop the messages from its queue, so
+	 * only send them once the batch is committed. Otherwise answer with an
+	 * error so the whole batch is sent again.
+	 */
+	if (slurmdbd_conn->conn->rem_port &&
+	    (!slurmdbd_conf->commit_delay || register_ctld) &&
+	    (acct_storage_g_commit(slurmdbd_conn->db_conn, 1) !=
+	     SLURM_SUCCESS)) {
+		comment = "Failed to commit DBD_SEND_MULT_MSG";
+		error("CONN:%d %s", slurmdbd_conn->conn->fd, comment);
+		(void) acct_storage_g_commit(slurmdbd_conn->db_conn, 0);
+		FREE_NULL_LIST(list_msg.my_list);
+		*out_buffer = slurm_persist_make_rc_msg(slurmdbd_conn->conn,
+							SLURM_ERROR, comment,
+							DBD_SEND_MULT_MSG);
+		return SLURM_ERROR;
+	}
+
 	*out_buffer = init_buf(1024);
 	pack16((uint16_t) DBD_GOT_MULT_MSG, *out_buffer);
 	slurmdbd_pack_list_msg(&list_msg, slurmdbd_conn->conn->version,
@@ -3719,6 +3747,8 @@ extern int proc_req(void *conn, persist_msg_t *msg, buf_t **out_buffer)
 		      slurmdbd_conn->conn->fd,
 		      slurmdbd_msg_type_2_str(msg->msg_type, 1));
 	else if (slurmdbd_conn->conn->rem_port &&
+		 !slurmdbd_conn->in_mult_msg &&
+		 (msg->msg_type != DBD_SEND_MULT_MSG) &&
 		 (!slurmdbd_conf->commit_delay ||
 		  (msg->msg_type == DBD_REGISTER_CTLD))) {
 		/* If we are dealing with the slurmctld do the
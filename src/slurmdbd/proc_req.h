@@ -47,6 +47,7 @@ typedef struct {
 	slurm_persist_conn_t *conn;
 	slurm_persist_conn_t *conn_send;
 	void *db_conn; /* database connection */
+	bool in_mult_msg; /* processing DBD_SEND_MULT_MSG, defer commit */
 	char *tres_str;
 } slurmdbd_conn_t;
 
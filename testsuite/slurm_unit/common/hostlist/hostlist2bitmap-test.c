@@ -0,0 +1,213 @@
+/*****************************************************************************\
+ *  Copyright (C) SchedMD LLC.
+ *
+ *  This file is part of Slurm, a resource management program.
+ *  For details, see <https://slurm.schedmd.com/>.
+ *  Please also read the included file: DISCLAIMER.
+ *
+ *  Slurm is free software; you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation; either version 2 of the License, or (at your option)
+ *  any later version.
+ *
+ *  In addition, as a special exception, the copyright holders give permission
+ *  to link the code of portions of this program with the OpenSSL library under
+ *  certain conditions as described in each individual source file, and
+ *  distribute linked combinations including the two. You must obey the GNU
+ *  General Public License in all respects for all of the code used other than
+ *  OpenSSL. If you modify file(s) with this exception, you may extend this
+ *  exception to your version of the file(s), but you are not obligated to do
+ *  so. If you do not wish to do so, delete this exception statement from your
+ *  version.  If you delete this exception statement from all source files in
+ *  the program, then also delete it here.
+ *
+ *  Slurm is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with Slurm; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA.
+\*****************************************************************************/
+
+#include <check.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "src/common/bitstring.h"
+#include "src/common/hostlist.h"
+#include "src/common/log.h"
+#include "src/common/node_conf.h"
+#include "src/common/read_config.h"
+#include "src/common/xmalloc.h"
+#include "src/common/xstring.h"
+
+static char *node_names[] = {
+	"n1", "n2", "n3", "n10", "n010", "p001", "p002", "p3",
+	"r98", "r99", "r100", "q", NULL
+};
+
+static void _add_node(config_record_t *config_ptr, char *name)
+{
+	node_record_t *node_ptr = NULL;
+
+	ck_assert_int_eq(create_node_record(config_ptr, name, &node_ptr),
+			 SLURM_SUCCESS);
+	ck_assert_ptr_ne(node_ptr, NULL);
+}
+
+static void _setup_nodes(void)
+{
+	config_record_t *config_ptr;
+
+	slurm_conf.max_node_cnt = NO_VAL;
+	init_node_conf();
+	config_ptr = create_config_record();
+	for (int i = 0; node_names[i]; i++)
+		_add_node(config_ptr, node_names[i]);
+	rehash_node();
+}
+
+/*
+ * Convert hosts through both node_name2bitmap() and hostlist2bitmap() and
+ * compare the nodes set with expected.
+ */
+static void _check_bitmap(char *hosts, bool best_effort, int rc,
+			  char *expected)
+{
+	bitstr_t *bitmap = NULL;
+	hostlist_t *hl;
+	char *str;
+
+	ck_assert_int_eq(node_name2bitmap(hosts, best_effort, &bitmap), rc);
+	str = bitmap2node_name(bitmap);
+	ck_assert_str_eq(str, expected);
+	xfree(str);
+	FREE_NULL_BITMAP(bitmap);
+
+	hl = hostlist_create(hosts);
+	ck_assert_int_eq(hostlist2bitmap(hl, best_effort, &bitmap), rc);
+	str = bitmap2node_name(bitmap);
+	ck_assert_str_eq(str, expected);
+	xfree(str);
+	FREE_NULL_BITMAP(bitmap);
+	hostlist_destroy(hl);
+}
+
+START_TEST(hostlist2bitmap_single_check)
+{
+	_setup_nodes();
+
+	_check_bitmap("q", false, SLURM_SUCCESS, "q");
+	_check_bitmap("n2", false, SLURM_SUCCESS, "n2");
+	_check_bitmap("n010,q", false, SLURM_SUCCESS, "n010,q");
+	_check_bitmap("n10,p3", false, SLURM_SUCCESS, "n10,p3");
+	_check_bitmap("n01", false, EINVAL, "");
+	_check_bitmap("n01,q", true, SLURM_SUCCESS, "q");
+}
+END_TEST
+
+START_TEST(hostlist2bitmap_padded_check)
+{
+	_setup_nodes();
+
+	_check_bitmap("n[1-3]", false, SLURM_SUCCESS, "n[1-3]");
+	_check_bitmap("n[1-3,10]", false, SLURM_SUCCESS, "n[1-3,10]");
+	_check_bitmap("n[010]", false, SLURM_SUCCESS, "n010");
+	_check_bitmap("p[001-002]", false, SLURM_SUCCESS, "p[001-002]");
+
+	/* Zero padded ranges do not match unpadded names, nor vice versa */
+	_check_bitmap("n[01-03]", false, EINVAL, "");
+	_check_bitmap("n[01-03]", true, SLURM_SUCCESS, "");
+	_check_bitmap("n[08-10]", true, SLURM_SUCCESS, "n10");
+	_check_bitmap("p[1-3]", false, EINVAL, "p3");
+	_check_bitmap("p[001-003]", true, SLURM_SUCCESS, "p[001-002]");
+
+	/* Padding never truncates, so r[98-100] includes r100 */
+	_check_bitmap("r[98-100]", false, SLURM_SUCCESS, "r[98-100]");
+	_check_bitmap("r[098-100]", true, SLURM_SUCCESS, "r100");
+}
+END_TEST
+
+START_TEST(hostlist2bitmap_unindexed_check)
+{
+	config_record_t *config_ptr;
+
+	_setup_nodes();
+
+	/* Nodes added since the last rehash_node() are not in the index */
+	config_ptr = create_config_record();
+	_add_node(config_ptr, "n4");
+	_add_node(config_ptr, "s1");
+	_add_node(config_ptr, "p004");
+
+	_check_bitmap("n[1-4]", false, SLURM_SUCCESS, "n[1-4]");
+	_check_bitmap("s[1-2]", false, EINVAL, "s1");
+	_check_bitmap("p[001-004]", true, SLURM_SUCCESS, "p[001-002,004]");
+
+	rehash_node();
+	_check_bitmap("n[1-4]", false, SLURM_SUCCESS, "n[1-4]");
+	_check_bitmap("s[1-2]", false, EINVAL, "s1");
+}
+END_TEST
+
+/*****************************************************************************
+ * TEST SUITE                                                                *
+ ****************************************************************************/
+
+Suite *make_hostlist2bitmap_suite(void)
+{
+	Suite *s = suite_create("hostlist2bitmap");
+	TCase *tc_core = tcase_create("hostlist2bitmap");
+	tcase_add_test(tc_core, hostlist2bitmap_single_check);
+	tcase_add_test(tc_core, hostlist2bitmap_padded_check);
+	tcase_add_test(tc_core, hostlist2bitmap_unindexed_check);
+	suite_add_tcase(s, tc_core);
+	return s;
+}
+
+/*****************************************************************************
+ * TEST RUNNER                                                               *
+ ****************************************************************************/
+
+int main(void)
+{
+	int fd, number_failed;
+	char *conf_file = xstrdup("slurm_unit.conf-XXXXXX");
+	/*
+	 * Names not found in the node table are looked up as aliases in
+	 * slurm.conf, so load a mock one. PluginDir=. is needed as 'make check'
+	 * doesn't install anything.
+	 */
+	char conf_content[] = "ClusterName=slurm_unit\n"
+			      "PluginDir=.\n"
+			      "SlurmctldHost=slurm_unit\n";
+	SRunner *sr;
+
+	if ((fd = mkstemp(conf_file)) == -1) {
+		error("error creating slurm_unit.conf (%s)", conf_file);
+		return EXIT_FAILURE;
+	}
+	if (write(fd, conf_content, sizeof(conf_content)) <
+	    sizeof(conf_content)) {
+		error("error writing slurm_unit.conf (%s)", conf_file);
+		return EXIT_FAILURE;
+	}
+	if (slurm_conf_init(conf_file) != SLURM_SUCCESS) {
+		error("slurm_conf_init() failed");
+		return EXIT_FAILURE;
+	}
+	unlink(conf_file);
+	xfree(conf_file);
+	close(fd);
+
+	sr = srunner_create(make_hostlist2bitmap_suite());
+
+	srunner_run_all(sr, CK_VERBOSE);
+	number_failed = srunner_ntests_failed(sr);
+	srunner_free(sr);
+
+	return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
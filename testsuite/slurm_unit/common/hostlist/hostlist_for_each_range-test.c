@@ -0,0 +1,144 @@
+/*****************************************************************************\
+ *  Copyright (C) SchedMD LLC.
+ *
+ *  This file is part of Slurm, a resource management program.
+ *  For details, see <https://slurm.schedmd.com/>.
+ *  Please also read the included file: DISCLAIMER.
+ *
+ *  Slurm is free software; you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation; either version 2 of the License, or (at your option)
+ *  any later version.
+ *
+ *  In addition, as a special exception, the copyright holders give permission
+ *  to link the code of portions of this program with the OpenSSL library under
+ *  certain conditions as described in each individual source file, and
+ *  distribute linked combinations including the two. You must obey the GNU
+ *  General Public License in all respects for all of the code used other than
+ *  OpenSSL. If you modify file(s) with this exception, you may extend this
+ *  exception to your version of the file(s), but you are not obligated to do
+ *  so. If you do not wish to do so, delete this exception statement from your
+ *  version.  If you delete this exception statement from all source files in
+ *  the program, then also delete it here.
+ *
+ *  Slurm is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with Slurm; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA.
+\*****************************************************************************/
+
+#include <check.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "src/common/hostlist.h"
+#include "src/common/xmalloc.h"
+#include "src/common/xstring.h"
+
+/* Append each range to arg as "prefix" or "prefix:lo-hi/width" */
+static int _print_range(const char *prefix, unsigned long lo,
+			unsigned long hi, int width, bool single, void *arg)
+{
+	char **str = arg;
+
+	if (*str)
+		xstrcat(*str, " ");
+	if (single)
+		xstrcat(*str, prefix);
+	else
+		xstrfmtcat(*str, "%s:%lu-%lu/%d", prefix, lo, hi, width);
+
+	return 0;
+}
+
+/* Count the ranges visited, stopping at the second one */
+static int _stop_range(const char *prefix, unsigned long lo,
+		       unsigned long hi, int width, bool single, void *arg)
+{
+	int *cnt = arg;
+
+	return (++(*cnt) == 2) ? 42 : 0;
+}
+
+static void _check_ranges(char *hosts, char *expected)
+{
+	hostlist_t *hl = hostlist_create(hosts);
+	char *str = NULL;
+
+	ck_assert_int_eq(hostlist_for_each_range(hl, _print_range, &str), 0);
+	ck_assert_str_eq(str, expected);
+
+	xfree(str);
+	hostlist_destroy(hl);
+}
+
+START_TEST(for_each_range_single_check)
+{
+	_check_ranges("alpha", "alpha");
+	_check_ranges("alpha,beta", "alpha beta");
+	_check_ranges("n1", "n:1-1/1");
+	_check_ranges("n010", "n:10-10/3");
+	_check_ranges("n,n1", "n n:1-1/1");
+}
+END_TEST
+
+START_TEST(for_each_range_padded_check)
+{
+	_check_ranges("n[1-9]", "n:1-9/1");
+	_check_ranges("n[01-10]", "n:1-10/2");
+	_check_ranges("n[8-11]", "n:8-11/1");
+	_check_ranges("n[098-101]", "n:98-101/3");
+	_check_ranges("n[1-3,5],m[001-002]", "n:1-3/1 n:5-5/1 m:1-2/3");
+	_check_ranges("rack1-n[1-2]", "rack1-n:1-2/1");
+}
+END_TEST
+
+START_TEST(for_each_range_stop_check)
+{
+	hostlist_t *hl = hostlist_create("n[1-3],m,p[1-2]");
+	char *str = NULL;
+	int cnt = 0;
+
+	ck_assert_int_eq(hostlist_for_each_range(NULL, _print_range, &str),
+			 -1);
+	ck_assert_int_eq(hostlist_for_each_range(hl, _stop_range, &cnt), 42);
+	ck_assert_int_eq(cnt, 2);
+
+	hostlist_destroy(hl);
+}
+END_TEST
+
+/*****************************************************************************
+ * TEST SUITE                                                                *
+ ****************************************************************************/
+
+Suite *make_for_each_range_suite(void)
+{
+	Suite *s = suite_create("hostlist_for_each_range");
+	TCase *tc_core = tcase_create("hostlist_for_each_range");
+	tcase_add_test(tc_core, for_each_range_single_check);
+	tcase_add_test(tc_core, for_each_range_padded_check);
+	tcase_add_test(tc_core, for_each_range_stop_check);
+	suite_add_tcase(s, tc_core);
+	return s;
+}
+
+/*****************************************************************************
+ * TEST RUNNER                                                               *
+ ****************************************************************************/
+
+int main(void)
+{
+	int number_failed;
+	SRunner *sr = srunner_create(make_for_each_range_suite());
+
+	srunner_run_all(sr, CK_VERBOSE);
+	number_failed = srunner_ntests_failed(sr);
+	srunner_free(sr);
+
+	return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,164 @@
+/*****************************************************************************\
+ *  Copyright (C) SchedMD LLC.
+ *
+ *  This file is part of Slurm, a resource management program.
+ *  For details, see <https://slurm.schedmd.com/>.
+ *  Please also read the included file: DISCLAIMER.
+ *
+ *  Slurm is free software; you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation; either version 2 of the License, or (at your option)
+ *  any later version.
+ *
+ *  In addition, as a special exception, the copyright holders give permission
+ *  to link the code of portions of this program with the OpenSSL library under
+ *  certain conditions as described in each individual source file, and
+ *  distribute linked combinations including the two. You must obey the GNU
+ *  General Public License in all respects for all of the code used other than
+ *  OpenSSL. If you modify file(s) with this exception, you may extend this
+ *  exception to your version of the file(s), but you are not obligated to do
+ *  so. If you do not wish to do so, delete this exception statement from your
+ *  version.  If you delete this exception statement from all source files in
+ *  the program, then also delete it here.
+ *
+ *  Slurm is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with Slurm; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301  USA.
+\*****************************************************************************/
+
+#include <check.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "src/common/hostlist.h"
+#include "src/common/xmalloc.h"
+
+/*
+ * Insert each of the hosts strings one at a time into an empty hostset, then
+ * compare the result with expected. Also check that hostlist_uniq() produces
+ * the same list from the concatenated strings.
+ */
+static void _check_insert(char **hosts, int cnt, char *expected)
+{
+	hostset_t *hs = hostset_create(NULL);
+	hostlist_t *hl = hostlist_create(NULL);
+	char *str;
+
+	for (int i = 0; i < cnt; i++) {
+		hostset_insert(hs, hosts[i]);
+		hostlist_push(hl, hosts[i]);
+	}
+
+	str = hostset_ranged_string_xmalloc(hs);
+	ck_assert_str_eq(str, expected);
+	xfree(str);
+
+	hostlist_uniq(hl);
+	str = hostlist_ranged_string_xmalloc(hl);
+	ck_assert_str_eq(str, expected);
+	xfree(str);
+
+	hostset_destroy(hs);
+	hostlist_destroy(hl);
+}
+
+START_TEST(hostset_insert_mixed_width_check)
+{
+	char *order1[] = { "n[1-9]", "n[01-10]", "n010", "n" };
+	char *order2[] = { "n010", "n", "n[01-10]", "n[1-9]" };
+	char *order3[] = { "n", "n[1-9]", "n010", "n[01-10]" };
+	char *order4[] = { "n[01-10]", "n010", "n[1-9]", "n" };
+
+	_check_insert(order1, 4, "n,n[1-9,01-10,010]");
+	_check_insert(order2, 4, "n,n[1-9,01-10,010]");
+	_check_insert(order3, 4, "n,n[1-9,01-10,010]");
+	_check_insert(order4, 4, "n,n[1-9,01-10,010]");
+}
+END_TEST
+
+START_TEST(hostset_insert_padded_check)
+{
+	char *hosts1[] = { "n[001-003]", "n1", "n01", "n[8-11]" };
+	char *hosts2[] = { "n5", "n05", "n005", "n[4-6]" };
+	char *hosts3[] = { "n[098-101]", "n[99-100]", "n0100", "n100" };
+
+	_check_insert(hosts1, 4, "n[1,8-11,01,001-003]");
+	_check_insert(hosts2, 4, "n[4-6,05,005]");
+	_check_insert(hosts3, 4, "n[99-100,098-101,0100]");
+}
+END_TEST
+
+START_TEST(hostset_insert_singlehost_check)
+{
+	char *hosts1[] = { "nn", "n[1-3]", "n", "n2" };
+	char *hosts2[] = { "m2", "n", "m", "m[1-3]", "n1" };
+
+	_check_insert(hosts1, 4, "n,n[1-3],nn");
+	_check_insert(hosts2, 5, "m,m[1-3],n,n1");
+}
+END_TEST
+
+START_TEST(hostset_insert_sorted_check)
+{
+	hostset_t *hs = hostset_create(NULL);
+	char host[16], *str;
+
+	/* Every other host backwards, then fill in the gaps */
+	for (int i = 1000; i > 0; i -= 2) {
+		snprintf(host, sizeof(host), "n%d", i);
+		ck_assert_int_eq(hostset_insert(hs, host), 1);
+	}
+	for (int i = 1; i < 1000; i += 2) {
+		snprintf(host, sizeof(host), "n%d", i);
+		ck_assert_int_eq(hostset_insert(hs, host), 1);
+	}
+	ck_assert_int_eq(hostset_count(hs), 1000);
+
+	/* Overlapping ranges only count the new hosts */
+	ck_assert_int_eq(hostset_insert(hs, "n[995-1005]"), 5);
+	ck_assert_int_eq(hostset_insert(hs, "n[1-3],m1"), 1);
+
+	str = hostset_ranged_string_xmalloc(hs);
+	ck_assert_str_eq(str, "m1,n[1-1005]");
+	xfree(str);
+
+	hostset_destroy(hs);
+}
+END_TEST
+
+/*****************************************************************************
+ * TEST SUITE                                                                *
+ ****************************************************************************/
+
+Suite *make_hostset_suite(void)
+{
+	Suite *s = suite_create("hostset_insert");
+	TCase *tc_core = tcase_create("hostset_insert");
+	tcase_add_test(tc_core, hostset_insert_mixed_width_check);
+	tcase_add_test(tc_core, hostset_insert_padded_check);
+	tcase_add_test(tc_core, hostset_insert_singlehost_check);
+	tcase_add_test(tc_core, hostset_insert_sorted_check);
+	suite_add_tcase(s, tc_core);
+	return s;
+}
+
+/*****************************************************************************
+ * TEST RUNNER                                                               *
+ ****************************************************************************/
+
+int main(void)
+{
+	int number_failed;
+	SRunner *sr = srunner_create(make_hostset_suite());
+
+	srunner_run_all(sr, CK_VERBOSE);
+	number_failed = srunner_ntests_failed(sr);
+	srunner_free(sr);
+
+	return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}